@@ -0,0 +1,6 @@
+module.exports = require('./webpack.config.base')({
+  target: 'lazy_renderer',
+  loadElectronFromAlternateTarget: 'sandboxed_renderer',
+  alwaysHasNode: false,
+  wrapInitWithTryCatch: true
+});
@@ -0,0 +1,144 @@
+import { app, BrowserWindow } from 'electron/main';
+import type { BrowserWindowConstructorOptions, BrowserWindowPoolConstructorOptions } from 'electron/main';
+
+// Keeps hidden windows that have already spawned their renderer process and
+// run their preload script, so they can be handed out without that latency.
+export default class BrowserWindowPool implements Electron.BrowserWindowPool {
+  _size: number;
+  _options: BrowserWindowConstructorOptions;
+  _url: string;
+  _spares: BrowserWindow[] = [];
+  _discarders = new Map<BrowserWindow, () => void>();
+  _warming: BrowserWindow | null = null;
+  _destroyed = false;
+  _paused = false;
+  _hits = 0;
+  _misses = 0;
+  _evictions = 0;
+  _onMemoryPressure: () => void;
+  _onWillQuit: () => void;
+
+  constructor (options: BrowserWindowPoolConstructorOptions = {}) {
+    const { size = 1, url = 'about:blank', windowOptions = {} } = options;
+    if (!Number.isInteger(size) || size < 0) {
+      throw new TypeError('size must be a non-negative integer');
+    }
+    this._size = size;
+    this._url = url;
+    this._options = { ...windowOptions, show: false };
+
+    this._onMemoryPressure = () => this._evict();
+    this._onWillQuit = () => this.destroy();
+    app.on('-memory-pressure' as any, this._onMemoryPressure);
+    app.once('will-quit', this._onWillQuit);
+
+    this._fill();
+  }
+
+  get size () {
+    return this._size;
+  }
+
+  set size (size: number) {
+    if (!Number.isInteger(size) || size < 0) {
+      throw new TypeError('size must be a non-negative integer');
+    }
+    this._size = size;
+    while (this._spares.length > size) {
+      this._spares.pop()!.destroy();
+    }
+    this._fill();
+  }
+
+  acquire () {
+    if (this._destroyed) {
+      throw new Error('BrowserWindowPool has been destroyed');
+    }
+    // A successful claim means it is worth warming windows again after a
+    // memory pressure eviction.
+    this._paused = false;
+    const win = this._spares.shift();
+    let result: BrowserWindow;
+    if (win) {
+      this._hits++;
+      // Once claimed the window belongs to the caller.
+      const discard = this._discarders.get(win)!;
+      this._discarders.delete(win);
+      win.webContents.removeListener('render-process-gone', discard);
+      win.removeListener('closed', discard);
+      result = win;
+    } else {
+      this._misses++;
+      result = this._createWindow();
+    }
+    this._fill();
+    return result;
+  }
+
+  getMetrics () {
+    return {
+      hits: this._hits,
+      misses: this._misses,
+      evictions: this._evictions,
+      available: this._spares.length
+    };
+  }
+
+  destroy () {
+    if (this._destroyed) return;
+    this._destroyed = true;
+    app.removeListener('-memory-pressure' as any, this._onMemoryPressure);
+    app.removeListener('will-quit', this._onWillQuit);
+    this._destroyWindows();
+  }
+
+  // Only called on memory pressure, tearing the pool down is not an eviction.
+  _evict () {
+    this._paused = true;
+    this._evictions += this._spares.length;
+    this._destroyWindows();
+  }
+
+  _destroyWindows () {
+    for (const win of this._spares.splice(0)) {
+      win.destroy();
+    }
+    if (this._warming) {
+      const warming = this._warming;
+      this._warming = null;
+      warming.destroy();
+    }
+  }
+
+  _createWindow () {
+    const win = new BrowserWindow(this._options);
+    win.loadURL(this._url).catch(() => {});
+    return win;
+  }
+
+  // Windows are warmed one at a time so that refilling the pool does not
+  // compete with the window that was just handed out.
+  _fill () {
+    if (this._destroyed || this._paused || this._warming) return;
+    if (this._spares.length >= this._size) return;
+
+    const win = this._warming = this._createWindow();
+    // Spare windows that crash or get closed are dropped from the pool.
+    const discard = () => {
+      const index = this._spares.indexOf(win);
+      if (index !== -1) this._spares.splice(index, 1);
+      if (this._warming === win) this._warming = null;
+      this._discarders.delete(win);
+      if (!win.isDestroyed()) win.destroy();
+    };
+    this._discarders.set(win, discard);
+    win.webContents.once('render-process-gone', discard);
+    win.once('closed', discard);
+    win.webContents.once('did-stop-loading', () => {
+      if (this._warming !== win) return;
+      this._warming = null;
+      this._spares.push(win);
+      setImmediate(() => this._fill());
+    });
+  }
+}
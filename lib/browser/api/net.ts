@@ -137,18 +137,18 @@ class IncomingMessage extends Readable {
 
 /** Writable stream that buffers up everything written to it. */
 class SlurpStream extends Writable {
-  _data: Buffer;
+  _chunks: Buffer[];
   constructor () {
     super();
-    this._data = Buffer.alloc(0);
+    this._chunks = [];
   }
 
   _write (chunk: Buffer, encoding: string, callback: () => void) {
-    this._data = Buffer.concat([this._data, chunk]);
+    this._chunks.push(chunk);
     callback();
   }
 
-  data () { return this._data; }
+  data () { return this._chunks.length === 1 ? this._chunks[0] : Buffer.concat(this._chunks); }
 }
 
 class ChunkedBodyStream extends Writable {
@@ -257,6 +257,18 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     throw new TypeError('headers must be an object');
   }
 
+  if (options.bufferSize != null && (!Number.isInteger(options.bufferSize) || options.bufferSize <= 0)) {
+    throw new TypeError('bufferSize must be a positive integer');
+  }
+
+  if (options.savePath != null && typeof options.savePath !== 'string') {
+    throw new TypeError('savePath must be a string');
+  }
+
+  if (options.uploadFile != null && typeof options.uploadFile !== 'string' && !Number.isInteger(options.uploadFile)) {
+    throw new TypeError('uploadFile must be a path or a file descriptor');
+  }
+
   const urlLoaderOptions: NodeJS.CreateURLLoaderOptions & { redirectPolicy: RedirectPolicy, headers: Record<string, { name: string, value: string | string[] }> } = {
     method: (options.method || 'GET').toUpperCase(),
     url: urlStr,
@@ -265,7 +277,10 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     body: null as any,
     useSessionCookies: options.useSessionCookies,
     credentials: options.credentials,
-    origin: options.origin
+    origin: options.origin,
+    bufferSize: options.bufferSize,
+    savePath: options.savePath,
+    uploadFile: options.uploadFile
   };
   const headers: Record<string, string | string[]> = options.headers || {};
   for (const [name, value] of Object.entries(headers)) {
@@ -335,6 +350,9 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     if (typeof this._chunkedEncoding !== 'undefined') {
       throw new Error('chunkedEncoding can only be set once');
     }
+    if (value && this._urlLoaderOptions.uploadFile != null) {
+      throw new Error('chunkedEncoding can not be used with uploadFile');
+    }
     this._chunkedEncoding = !!value;
     if (this._chunkedEncoding) {
       this._body = new ChunkedBodyStream(this);
@@ -388,7 +406,11 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     delete this._urlLoaderOptions.headers[key];
   }
 
-  _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
+  _write (chunk: Buffer, encoding: BufferEncoding, callback: (error?: Error) => void) {
+    if (this._urlLoaderOptions.uploadFile != null) {
+      callback(new Error('Can\'t write a body when uploadFile is set'));
+      return;
+    }
     this._firstWrite = true;
     if (!this._body) {
       this._body = new SlurpStream();
@@ -187,9 +187,37 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (worldId
   return ipcMainUtils.invokeInWebContents(this, IPC_MESSAGES.RENDERER_WEB_FRAME_METHOD, 'executeJavaScriptInIsolatedWorld', worldId, code, !!hasUserGesture);
 };
 
+// printToPDF requests are queued so that rendering many PDFs does not keep all
+// of them in memory at once. A WebContents only renders one PDF at a time, and
+// at most |printToPDFConcurrency| render across all WebContents.
+let printToPDFConcurrency = 1;
+let activePrintToPDFRequests = 0;
+const queuedPrintToPDFRequests: (() => void)[] = [];
+const lastPrintToPDFRequest = new WeakMap<Electron.WebContents, Promise<unknown>>();
+
+const startQueuedPrintToPDFRequests = () => {
+  while (activePrintToPDFRequests < printToPDFConcurrency && queuedPrintToPDFRequests.length > 0) {
+    activePrintToPDFRequests++;
+    queuedPrintToPDFRequests.shift()!();
+  }
+};
+
+const enqueuePrintToPDF = <T>(contents: Electron.WebContents, job: () => Promise<T>): Promise<T> => {
+  const previous = lastPrintToPDFRequest.get(contents) || Promise.resolve();
+  const result = previous.then(() => new Promise<void>(resolve => {
+    queuedPrintToPDFRequests.push(resolve);
+    startQueuedPrintToPDFRequests();
+  })).then(job).finally(() => {
+    activePrintToPDFRequests--;
+    startQueuedPrintToPDFRequests();
+  });
+  // A failed request must not fail the ones queued after it.
+  lastPrintToPDFRequest.set(contents, result.catch(() => {}));
+  return result;
+};
+
 // Translate the options of printToPDF.
 
-let pendingPromise: Promise<any> | undefined;
 WebContents.prototype.printToPDF = async function (options) {
   const printSettings: Record<string, any> = {
     ...defaultPrintingSetting,
@@ -318,17 +346,21 @@ WebContents.prototype.printToPDF = async function (options) {
     printSettings.mediaSize = PDFPageSizes.A4;
   }
 
+  if (options.path !== undefined) {
+    if (typeof options.path !== 'string' || options.path === '') {
+      const error = new Error('path must be a non-empty String');
+      return Promise.reject(error);
+    }
+  }
+
   // Chromium expects this in a 0-100 range number, not as float
   printSettings.scaleFactor = Math.ceil(printSettings.scaleFactor) % 100;
   // PrinterType enum from //printing/print_job_constants.h
   printSettings.printerType = 2;
   if (this._printToPDF) {
-    if (pendingPromise) {
-      pendingPromise = pendingPromise.then(() => this._printToPDF(printSettings));
-    } else {
-      pendingPromise = this._printToPDF(printSettings);
-    }
-    return pendingPromise;
+    // When written to a file the data is not returned.
+    return enqueuePrintToPDF(this, () => this._printToPDF(printSettings, options.path))
+      .then(data => data || Buffer.alloc(0));
   } else {
     const error = new Error('Printing feature is disabled');
     return Promise.reject(error);
@@ -783,3 +815,11 @@ export function getFocusedWebContents () {
 export function getAllWebContents () {
   return binding.getAllWebContents();
 }
+
+export function setPrintToPDFConcurrency (concurrency: number) {
+  if (!Number.isInteger(concurrency) || concurrency < 1) {
+    throw new TypeError('concurrency must be a positive integer');
+  }
+  printToPDFConcurrency = concurrency;
+  startQueuedPrintToPDFRequests();
+}
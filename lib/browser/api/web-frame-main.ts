@@ -1,6 +1,6 @@
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 
-const { WebFrameMain, fromId } = process._linkedBinding('electron_browser_web_frame_main');
+const { WebFrameMain, fromId, _broadcast } = process._linkedBinding('electron_browser_web_frame_main');
 
 WebFrameMain.prototype.send = function (channel, ...args) {
   if (typeof channel !== 'string') {
@@ -25,6 +25,18 @@ WebFrameMain.prototype.postMessage = function (...args) {
   this._postMessage(...args);
 };
 
+const broadcast = (frames: Electron.WebFrameMain[], channel: string, ...args: any[]) => {
+  if (!Array.isArray(frames)) {
+    throw new TypeError('frames must be an array of WebFrameMain');
+  }
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument');
+  }
+
+  return _broadcast(frames, false /* internal */, channel, args);
+};
+
 export default {
-  fromId
+  fromId,
+  broadcast
 };
@@ -1,12 +1,19 @@
 import { EventEmitter } from 'events';
 
+const wrapPorts = (event: {ports: any[]}) => ({ ...event, ports: event.ports.map(p => new MessagePortMain(p)) });
+
 export class MessagePortMain extends EventEmitter {
   _internalPort: any
   constructor (internalPort: any) {
     super();
     this._internalPort = internalPort;
-    this._internalPort.emit = (channel: string, event: {ports: any[]}) => {
-      if (channel === 'message') { event = { ...event, ports: event.ports.map(p => new MessagePortMain(p)) }; }
+    this._internalPort.emit = (channel: string, event: any) => {
+      if (channel === 'messages') {
+        // A batch of messages delivered with a single call from native code.
+        for (const e of event) this.emit('message', wrapPorts(e));
+        return;
+      }
+      if (channel === 'message') { event = wrapPorts(event); }
       this.emit(channel, event);
     };
   }
@@ -15,6 +22,10 @@ export class MessagePortMain extends EventEmitter {
     return this._internalPort.start();
   }
 
+  enableBatching (options?: { maxMessages?: number, maxDuration?: number }) {
+    return this._internalPort.enableBatching(options);
+  }
+
   close () {
     return this._internalPort.close();
   }
@@ -0,0 +1,73 @@
+/* global binding */
+
+// Initializes a frame that has no Node.js environment, either because it can
+// not use one or because it has deferred it with the lazyNodeEnvironment
+// option. It applies the window overrides and handles internal IPC until
+// renderer/init.ts runs, and keeps handling internal IPC afterwards so that
+// listeners registered here keep working.
+
+import type * as ipcRendererInternalModule from '@electron/internal/renderer/ipc-renderer-internal';
+import type * as securityWarningsModule from '@electron/internal/renderer/security-warnings';
+import type * as webFrameInitModule from '@electron/internal/renderer/web-frame-init';
+import type * as webViewInitModule from '@electron/internal/renderer/web-view/web-view-init';
+import type * as windowSetupModule from '@electron/internal/renderer/window-setup';
+
+process._linkedBinding = binding.get;
+Object.assign(process, binding.process);
+
+const v8Util = process._linkedBinding('electron_common_v8_util');
+
+const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal') as typeof ipcRendererInternalModule;
+
+// ElectronApiServiceImpl will look for the "ipcNative" hidden object when
+// invoking the 'onMessage' callback. Nothing can listen to the public
+// ipcRenderer before the Node.js environment exists, so only internal
+// messages are handled here.
+v8Util.setHiddenValue(global, 'ipcNative', {
+  onMessage (internal: boolean, channel: string, ports: MessagePort[], args: any[], senderId: number) {
+    if (!internal) return;
+    if (senderId !== 0) {
+      console.error(`Message ${channel} sent by unexpected WebContents (${senderId})`);
+      return;
+    }
+    ipcRendererInternal.emit(channel, { sender: ipcRendererInternal, senderId, ports }, ...args);
+  }
+});
+
+const { webFrameInit } = require('@electron/internal/renderer/web-frame-init') as typeof webFrameInitModule;
+webFrameInit();
+
+const { mainFrame } = process._linkedBinding('electron_renderer_web_frame');
+
+const contextIsolation = mainFrame.getWebPreference('contextIsolation');
+const nodeIntegration = mainFrame.getWebPreference('nodeIntegration');
+const isHiddenPage = mainFrame.getWebPreference('hiddenPage');
+const usesNativeWindowOpen = mainFrame.getWebPreference('nativeWindowOpen');
+const guestInstanceId = mainFrame.getWebPreference('guestInstanceId');
+const openerId = mainFrame.getWebPreference('openerId');
+
+switch (window.location.protocol) {
+  case 'devtools:':
+  case 'chrome-extension:':
+  case 'chrome:': {
+    break;
+  }
+  default: {
+    // Override default web functions.
+    const { windowSetup } = require('@electron/internal/renderer/window-setup') as typeof windowSetupModule;
+    windowSetup(guestInstanceId, openerId, isHiddenPage, usesNativeWindowOpen);
+  }
+}
+
+// Frames with the webview tag never defer their environment, so only the
+// guest side of the webview implementation is needed.
+if (process.isMainFrame) {
+  const { webViewInit } = require('@electron/internal/renderer/web-view/web-view-init') as typeof webViewInitModule;
+  webViewInit(contextIsolation, false, guestInstanceId);
+}
+
+// Warn about security issues
+if (process.isMainFrame) {
+  const { securityWarnings } = require('@electron/internal/renderer/security-warnings') as typeof securityWarningsModule;
+  securityWarnings(nodeIntegration);
+}
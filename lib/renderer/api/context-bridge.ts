@@ -11,6 +11,10 @@ const contextBridge: Electron.ContextBridge = {
   exposeInMainWorld: (key: string, api: any) => {
     checkContextIsolationEnabled();
     return binding.exposeAPIInMainWorld(key, api);
+  },
+  transfer: (buffer: any) => {
+    checkContextIsolationEnabled();
+    return binding.markArrayBufferForTransfer(buffer);
   }
 };
 
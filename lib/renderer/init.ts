@@ -48,8 +48,17 @@ const v8Util = process._linkedBinding('electron_common_v8_util');
 const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal') as typeof ipcRendererInternalModule;
 const ipcRenderer = require('@electron/internal/renderer/api/ipc-renderer').default;
 
+// Frames that deferred their environment with lazyNodeEnvironment have
+// already been initialized by lazy_renderer/init.ts, whose ipcNative keeps
+// delivering the internal messages.
+const lazyIpcNative = v8Util.getHiddenValue<any>(global, 'ipcNative');
+
 v8Util.setHiddenValue(global, 'ipcNative', {
   onMessage (internal: boolean, channel: string, ports: any[], args: any[], senderId: number) {
+    if (internal && lazyIpcNative) {
+      lazyIpcNative.onMessage(internal, channel, ports, args, senderId);
+      return;
+    }
     if (internal && senderId !== 0) {
       console.error(`Message ${channel} sent by unexpected WebContents (${senderId})`);
       return;
@@ -60,8 +69,10 @@ v8Util.setHiddenValue(global, 'ipcNative', {
 });
 
 // Use electron module after everything is ready.
-const { webFrameInit } = require('@electron/internal/renderer/web-frame-init') as typeof webFrameInitModule;
-webFrameInit();
+if (!lazyIpcNative) {
+  const { webFrameInit } = require('@electron/internal/renderer/web-frame-init') as typeof webFrameInitModule;
+  webFrameInit();
+}
 
 // Process command line arguments.
 const { hasSwitch, getSwitchValue } = process._linkedBinding('electron_common_command_line');
@@ -97,13 +108,15 @@ switch (window.location.protocol) {
   }
   default: {
     // Override default web functions.
-    const { windowSetup } = require('@electron/internal/renderer/window-setup') as typeof windowSetupModule;
-    windowSetup(guestInstanceId, openerId, isHiddenPage, usesNativeWindowOpen);
+    if (!lazyIpcNative) {
+      const { windowSetup } = require('@electron/internal/renderer/window-setup') as typeof windowSetupModule;
+      windowSetup(guestInstanceId, openerId, isHiddenPage, usesNativeWindowOpen);
+    }
   }
 }
 
 // Load webview tag implementation.
-if (process.isMainFrame) {
+if (process.isMainFrame && !lazyIpcNative) {
   const { webViewInit } = require('@electron/internal/renderer/web-view/web-view-init') as typeof webViewInitModule;
   webViewInit(contextIsolation, webviewTag, guestInstanceId);
 }
@@ -188,7 +201,7 @@ for (const preloadScript of preloadScripts) {
 }
 
 // Warn about security issues
-if (process.isMainFrame) {
+if (process.isMainFrame && !lazyIpcNative) {
   const { securityWarnings } = require('@electron/internal/renderer/security-warnings') as typeof securityWarningsModule;
   securityWarnings(nodeIntegration);
 }
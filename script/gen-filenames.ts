@@ -25,6 +25,10 @@ const main = async () => {
       name: 'isolated_bundle_deps',
       config: 'webpack.config.isolated_renderer.js'
     },
+    {
+      name: 'lazy_bundle_deps',
+      config: 'webpack.config.lazy_renderer.js'
+    },
     {
       name: 'browser_bundle_deps',
       config: 'webpack.config.browser.js'
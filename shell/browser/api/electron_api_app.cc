@@ -15,7 +15,9 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/path_service.h"
-#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_restrictions.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/common/chrome_paths.h"
@@ -417,6 +419,101 @@ struct Converter<content::CertificateRequestResultType> {
   }
 };
 
+template <>
+struct Converter<electron::ProcessMetricSample> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::ProcessMetricSample& val) {
+    gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
+    gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+
+    pid_dict.SetHidden("simple", true);
+    cpu_dict.SetHidden("simple", true);
+    cpu_dict.Set("percentCPUUsage", val.percent_cpu_usage);
+    cpu_dict.Set("idleWakeupsPerSecond", val.idle_wakeups_per_second);
+
+    pid_dict.Set("cpu", cpu_dict);
+    pid_dict.Set("pid", val.pid);
+    pid_dict.Set("type", content::GetProcessTypeNameInEnglish(val.type));
+    pid_dict.Set("creationTime", val.creation_time);
+
+    if (!val.service_name.empty()) {
+      pid_dict.Set("serviceName", val.service_name);
+    }
+
+    if (!val.name.empty()) {
+      pid_dict.Set("name", val.name);
+    }
+
+    gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
+    memory_dict.SetHidden("simple", true);
+    memory_dict.Set("workingSetSize",
+                    static_cast<double>(val.memory.working_set_size >> 10));
+    memory_dict.Set(
+        "peakWorkingSetSize",
+        static_cast<double>(val.memory.peak_working_set_size >> 10));
+
+#if defined(OS_WIN)
+    memory_dict.Set("privateBytes",
+                    static_cast<double>(val.memory.private_bytes >> 10));
+#elif defined(OS_LINUX)
+    // smaps_rollup is only read for detailed samples.
+    if (val.memory.proportional_set_size) {
+      memory_dict.Set("privateBytes",
+                      static_cast<double>(val.memory.private_bytes >> 10));
+      memory_dict.Set(
+          "proportionalSetSize",
+          static_cast<double>(val.memory.proportional_set_size >> 10));
+    }
+#endif
+
+    pid_dict.Set("memory", memory_dict);
+
+    if (val.open_fd_count >= 0) {
+      pid_dict.Set("openFileDescriptors", val.open_fd_count);
+    }
+
+    if (val.io_counters) {
+      gin_helper::Dictionary io_dict = gin::Dictionary::CreateEmpty(isolate);
+      io_dict.SetHidden("simple", true);
+      io_dict.Set("readOperationCount",
+                  static_cast<double>(val.io_counters->ReadOperationCount));
+      io_dict.Set("writeOperationCount",
+                  static_cast<double>(val.io_counters->WriteOperationCount));
+      io_dict.Set("otherOperationCount",
+                  static_cast<double>(val.io_counters->OtherOperationCount));
+      io_dict.Set("readTransferCount",
+                  static_cast<double>(val.io_counters->ReadTransferCount));
+      io_dict.Set("writeTransferCount",
+                  static_cast<double>(val.io_counters->WriteTransferCount));
+      io_dict.Set("otherTransferCount",
+                  static_cast<double>(val.io_counters->OtherTransferCount));
+      pid_dict.Set("io", io_dict);
+    }
+
+#if defined(OS_MAC)
+    pid_dict.Set("sandboxed", val.sandboxed);
+#elif defined(OS_WIN)
+    pid_dict.Set("integrityLevel", val.integrity_level);
+    pid_dict.Set("sandboxed",
+                 electron::ProcessMetric::IsSandboxed(val.integrity_level));
+#endif
+
+    return pid_dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::AppMetricsSample> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::AppMetricsSample& val) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.SetHidden("simple", true);
+    dict.Set("timestamp", val.time.ToJsTime());
+    dict.Set("metrics", val.metrics);
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace gin
 
 namespace electron {
@@ -590,7 +687,16 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
 
 }  // namespace
 
-App::App() {
+App::App()
+    : memory_pressure_listener_(
+          FROM_HERE,
+          base::BindRepeating(&App::OnMemoryPressure, base::Unretained(this))),
+      metrics_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      // Created here and only used on |metrics_task_runner_| from then on.
+      metrics_sampler_(new electron::ProcessMetricsSampler,
+                       base::OnTaskRunnerDeleter(metrics_task_runner_)) {
   static_cast<ElectronBrowserClient*>(ElectronBrowserClient::Get())
       ->set_delegate(this);
   Browser::Get()->AddObserver(this);
@@ -600,6 +706,11 @@ App::App() {
       content::PROCESS_TYPE_BROWSER, base::GetCurrentProcessHandle(),
       base::ProcessMetrics::CreateCurrentProcessMetrics());
   app_metrics_[pid] = std::move(process_metric);
+
+  metrics_sampler_->AddProcess(
+      pid, std::make_unique<electron::ProcessMetric>(
+               content::PROCESS_TYPE_BROWSER, base::GetCurrentProcessHandle(),
+               base::ProcessMetrics::CreateCurrentProcessMetrics()));
 }
 
 App::~App() {
@@ -610,6 +721,18 @@ App::~App() {
   content::BrowserChildProcessObserver::Remove(this);
 }
 
+void App::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  Emit("-memory-pressure",
+       memory_pressure_level ==
+               base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL
+           ? "critical"
+           : "moderate");
+}
+
 void App::OnBeforeQuit(bool* prevent_default) {
   if (Emit("before-quit")) {
     *prevent_default = true;
@@ -888,18 +1011,31 @@ void App::ChildProcessLaunched(int process_type,
                                base::ProcessHandle handle,
                                const std::string& service_name,
                                const std::string& name) {
+  auto create_metric = [&]() {
 #if defined(OS_MAC)
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(
-      handle, content::BrowserChildProcessHost::GetPortProvider());
+    auto metrics = base::ProcessMetrics::CreateProcessMetrics(
+        handle, content::BrowserChildProcessHost::GetPortProvider());
 #else
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
+    auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
 #endif
-  app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
-      process_type, handle, std::move(metrics), service_name, name);
+    return std::make_unique<electron::ProcessMetric>(
+        process_type, handle, std::move(metrics), service_name, name);
+  };
+  app_metrics_[pid] = create_metric();
+
+  // The sampler keeps its own ProcessMetric so that CPU usage deltas are not
+  // shared with getAppMetrics() callers.
+  metrics_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&electron::ProcessMetricsSampler::AddProcess,
+                                base::Unretained(metrics_sampler_.get()), pid,
+                                create_metric()));
 }
 
 void App::ChildProcessDisconnected(int pid) {
   app_metrics_.erase(pid);
+  metrics_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&electron::ProcessMetricsSampler::RemoveProcess,
+                                base::Unretained(metrics_sampler_.get()), pid));
 }
 
 base::FilePath App::GetAppPath() const {
@@ -1319,79 +1455,104 @@ v8::Local<v8::Promise> App::GetFileIcon(const base::FilePath& path,
   return handle;
 }
 
-std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
-  std::vector<gin_helper::Dictionary> result;
+std::vector<electron::ProcessMetricSample> App::GetAppMetrics() {
+#if defined(OS_LINUX)
+  // The memory info is read from /proc, which does not touch the disk.
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+#endif
+
+  std::vector<electron::ProcessMetricSample> result;
   result.reserve(app_metrics_.size());
-  int processor_count = base::SysInfo::NumberOfProcessors();
+  for (const auto& process_metric : app_metrics_)
+    result.push_back(
+        process_metric.second->Sample(false /* detailed_memory */));
+  return result;
+}
 
-  for (const auto& process_metric : app_metrics_) {
-    gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
-    gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+v8::Local<v8::Promise> App::GetAppMetricsAsync(v8::Isolate* isolate) {
+  gin_helper::Promise<std::vector<electron::ProcessMetricSample>> promise(
+      isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
 
-    pid_dict.SetHidden("simple", true);
-    cpu_dict.SetHidden("simple", true);
-    cpu_dict.Set(
-        "percentCPUUsage",
-        process_metric.second->metrics->GetPlatformIndependentCPUUsage() /
-            processor_count);
-
-#if !defined(OS_WIN)
-    cpu_dict.Set("idleWakeupsPerSecond",
-                 process_metric.second->metrics->GetIdleWakeupsPerSecond());
-#else
-    // Chrome's underlying process_metrics.cc will throw a non-fatal warning
-    // that this method isn't implemented on Windows, so set it to 0 instead
-    // of calling it
-    cpu_dict.Set("idleWakeupsPerSecond", 0);
-#endif
+  base::PostTaskAndReplyWithResult(
+      metrics_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&electron::ProcessMetricsSampler::Sample,
+                     base::Unretained(metrics_sampler_.get())),
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<electron::ProcessMetricSample>>
+                 promise,
+             electron::AppMetricsSample sample) {
+            promise.Resolve(sample.metrics);
+          },
+          std::move(promise)));
 
-    pid_dict.Set("cpu", cpu_dict);
-    pid_dict.Set("pid", process_metric.second->process.Pid());
-    pid_dict.Set("type", content::GetProcessTypeNameInEnglish(
-                             process_metric.second->type));
-    pid_dict.Set("creationTime",
-                 process_metric.second->process.CreationTime().ToJsTime());
-
-    if (!process_metric.second->service_name.empty()) {
-      pid_dict.Set("serviceName", process_metric.second->service_name);
-    }
+  return handle;
+}
 
-    if (!process_metric.second->name.empty()) {
-      pid_dict.Set("name", process_metric.second->name);
-    }
+void App::StartAppMetricsSampling(gin::Arguments* args) {
+  double interval = 1000;
+  int max_samples = 60;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("interval", &interval);
+    options.Get("maxSamples", &max_samples);
+  }
+  if (interval <= 0) {
+    args->ThrowTypeError("interval must be a positive number");
+    return;
+  }
+  if (max_samples <= 0) {
+    args->ThrowTypeError("maxSamples must be a positive integer");
+    return;
+  }
 
-#if !defined(OS_LINUX)
-    auto memory_info = process_metric.second->GetMemoryInfo();
+  max_metrics_samples_ = max_samples;
+  while (metrics_samples_.size() > max_metrics_samples_)
+    metrics_samples_.pop_front();
 
-    gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
-    memory_dict.SetHidden("simple", true);
-    memory_dict.Set("workingSetSize",
-                    static_cast<double>(memory_info.working_set_size >> 10));
-    memory_dict.Set(
-        "peakWorkingSetSize",
-        static_cast<double>(memory_info.peak_working_set_size >> 10));
+  metrics_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMillisecondsD(interval),
+      base::BindRepeating(&App::SampleAppMetrics, base::Unretained(this)));
+}
 
-#if defined(OS_WIN)
-    memory_dict.Set("privateBytes",
-                    static_cast<double>(memory_info.private_bytes >> 10));
-#endif
+void App::StopAppMetricsSampling() {
+  metrics_timer_.Stop();
+}
 
-    pid_dict.Set("memory", memory_dict);
-#endif
+v8::Local<v8::Value> App::GetAppMetricsSamples(v8::Isolate* isolate,
+                                               absl::optional<double> since) {
+  std::vector<v8::Local<v8::Value>> samples;
+  for (const auto& sample : metrics_samples_) {
+    if (!since || sample.time.ToJsTime() > *since)
+      samples.push_back(gin::ConvertToV8(isolate, sample));
+  }
+  return gin::ConvertToV8(isolate, samples);
+}
 
-#if defined(OS_MAC)
-    pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
-#elif defined(OS_WIN)
-    auto integrity_level = process_metric.second->GetIntegrityLevel();
-    auto sandboxed = ProcessMetric::IsSandboxed(integrity_level);
-    pid_dict.Set("integrityLevel", integrity_level);
-    pid_dict.Set("sandboxed", sandboxed);
-#endif
+void App::SampleAppMetrics() {
+  // Skip a tick rather than queueing samples when sampling is slower than
+  // the interval.
+  if (metrics_sample_pending_)
+    return;
+  metrics_sample_pending_ = true;
 
-    result.push_back(pid_dict);
-  }
+  base::PostTaskAndReplyWithResult(
+      metrics_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&electron::ProcessMetricsSampler::Sample,
+                     base::Unretained(metrics_sampler_.get())),
+      base::BindOnce(&App::OnAppMetricsSampled, weak_factory_.GetWeakPtr()));
+}
 
-  return result;
+void App::OnAppMetricsSampled(electron::AppMetricsSample sample) {
+  metrics_sample_pending_ = false;
+  // Sampling may have been stopped while this sample was being taken.
+  if (!metrics_timer_.IsRunning())
+    return;
+
+  if (metrics_samples_.size() >= max_metrics_samples_)
+    metrics_samples_.pop_front();
+  metrics_samples_.push_back(std::move(sample));
+  Emit("app-metrics-sampled", metrics_samples_.back());
 }
 
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
@@ -1672,6 +1833,10 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("getAppMetricsAsync", &App::GetAppMetricsAsync)
+      .SetMethod("startAppMetricsSampling", &App::StartAppMetricsSampling)
+      .SetMethod("stopAppMetricsSampling", &App::StopAppMetricsSampling)
+      .SetMethod("getAppMetricsSamples", &App::GetAppMetricsSamples)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if defined(MAS_BUILD)
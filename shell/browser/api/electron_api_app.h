@@ -10,7 +10,12 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/circular_deque.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/task/cancelable_task_tracker.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/browser_child_process_observer.h"
@@ -207,7 +212,14 @@ class App : public ElectronBrowserClient::Delegate,
   v8::Local<v8::Promise> GetFileIcon(const base::FilePath& path,
                                      gin::Arguments* args);
 
-  std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  std::vector<electron::ProcessMetricSample> GetAppMetrics();
+  v8::Local<v8::Promise> GetAppMetricsAsync(v8::Isolate* isolate);
+  void StartAppMetricsSampling(gin::Arguments* args);
+  void StopAppMetricsSampling();
+  v8::Local<v8::Value> GetAppMetricsSamples(v8::Isolate* isolate,
+                                            absl::optional<double> since);
+  void SampleAppMetrics();
+  void OnAppMetricsSampled(electron::AppMetricsSample sample);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -251,15 +263,33 @@ class App : public ElectronBrowserClient::Delegate,
   // Tracks tasks requesting file icons.
   base::CancelableTaskTracker cancelable_task_tracker_;
 
+  // Forwards system memory pressure to JS, used by BrowserWindow pools.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  base::MemoryPressureListener memory_pressure_listener_;
+
   base::FilePath app_path_;
 
   using ProcessMetricMap =
       std::map<int, std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  // Samples the same processes as |app_metrics_| off the UI thread, for
+  // getAppMetricsAsync() and the metrics sampling timer.
+  scoped_refptr<base::SequencedTaskRunner> metrics_task_runner_;
+  std::unique_ptr<electron::ProcessMetricsSampler, base::OnTaskRunnerDeleter>
+      metrics_sampler_;
+  base::RepeatingTimer metrics_timer_;
+  bool metrics_sample_pending_ = false;
+  // Most recent samples taken by the timer, oldest first.
+  base::circular_deque<electron::AppMetricsSample> metrics_samples_;
+  size_t max_metrics_samples_ = 60;
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
 
+  base::WeakPtrFactory<App> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
@@ -4,17 +4,24 @@
 
 #include "shell/browser/api/electron_api_data_pipe_holder.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <utility>
-#include <vector>
 
+#include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "gin/object_template_builder.h"
 #include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/simple_watcher.h"
 #include "net/base/net_errors.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/key_weak_map.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 #include "shell/common/node_includes.h"
 
@@ -64,8 +71,19 @@ class DataPipeReader {
       OnFailure();
       return;
     }
-    buffer_.resize(size);
-    head_ = &buffer_.front();
+    if (size == 0) {
+      v8::Locker locker(promise_.isolate());
+      v8::HandleScope handle_scope(promise_.isolate());
+      promise_.Resolve(
+          node::Buffer::New(promise_.isolate(), 0).ToLocalChecked());
+      delete this;
+      return;
+    }
+    // Allocated uninitialized and at its final size, so large bodies are not
+    // zero-filled or reallocated while being read.
+    buffer_.reset(new char[size]);
+    buffer_size_ = size;
+    head_ = buffer_.get();
     remaining_size_ = size;
     handle_watcher_.ArmOrNotify();
   }
@@ -79,7 +97,8 @@ class DataPipeReader {
     }
 
     // Read.
-    uint32_t length = remaining_size_;
+    uint32_t length = static_cast<uint32_t>(std::min<uint64_t>(
+        remaining_size_, std::numeric_limits<uint32_t>::max()));
     result = data_pipe_->ReadData(head_, &length, MOJO_READ_DATA_FLAG_NONE);
     if (result == MOJO_RESULT_OK) {  // success
       remaining_size_ -= length;
@@ -106,7 +125,7 @@ class DataPipeReader {
     v8::Locker locker(promise_.isolate());
     v8::HandleScope handle_scope(promise_.isolate());
     v8::Local<v8::Value> buffer =
-        node::Buffer::New(promise_.isolate(), &buffer_.front(), buffer_.size(),
+        node::Buffer::New(promise_.isolate(), buffer_.get(), buffer_size_,
                           &DataPipeReader::FreeBuffer, this)
             .ToLocalChecked();
     promise_.Resolve(buffer);
@@ -128,7 +147,8 @@ class DataPipeReader {
   mojo::SimpleWatcher handle_watcher_;
 
   // Stores read data.
-  std::vector<char> buffer_;
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_size_ = 0;
 
   // The head of buffer.
   char* head_ = nullptr;
@@ -141,6 +161,223 @@ class DataPipeReader {
   DISALLOW_COPY_AND_ASSIGN(DataPipeReader);
 };
 
+// Reads from a data pipe one chunk at a time, on behalf of JS.
+//
+// The pipe has a fixed capacity and is only drained when JS asks for the next
+// chunk, so memory use does not depend on the size of the data.
+class DataPipeIterator : public gin::Wrappable<DataPipeIterator> {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  static gin::Handle<DataPipeIterator> Create(
+      v8::Isolate* isolate,
+      mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter) {
+    auto handle = gin::CreateHandle(
+        isolate, new DataPipeIterator(isolate, std::move(data_pipe_getter)));
+    // Make the object usable with "for await".
+    v8::Local<v8::Object> wrapper =
+        handle->GetWrapper(isolate).ToLocalChecked();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    ignore_result(wrapper->Set(
+        context, v8::Symbol::GetAsyncIterator(isolate),
+        v8::Function::New(
+            context,
+            [](const v8::FunctionCallbackInfo<v8::Value>& info) {
+              info.GetReturnValue().Set(info.This());
+            })
+            .ToLocalChecked()));
+    return handle;
+  }
+
+  // gin::Wrappable
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override {
+    return gin::Wrappable<DataPipeIterator>::GetObjectTemplateBuilder(isolate)
+        .SetMethod("next", &DataPipeIterator::Next)
+        .SetMethod("return", &DataPipeIterator::Return);
+  }
+
+ private:
+  // Upper bound of the data buffered in the pipe, and so of a single chunk.
+  static constexpr uint32_t kPipeCapacity = 64 * 1024;
+
+  DataPipeIterator(
+      v8::Isolate* isolate,
+      mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter)
+      : isolate_(isolate),
+        data_pipe_getter_(std::move(data_pipe_getter)),
+        handle_watcher_(FROM_HERE,
+                        mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                        base::SequencedTaskRunnerHandle::Get()) {
+    MojoCreateDataPipeOptions options;
+    options.struct_size = sizeof(MojoCreateDataPipeOptions);
+    options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+    options.element_num_bytes = 1;
+    options.capacity_num_bytes = kPipeCapacity;
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    CHECK_EQ(mojo::CreateDataPipe(&options, producer_handle, data_pipe_),
+             MOJO_RESULT_OK);
+    data_pipe_getter_->Read(std::move(producer_handle),
+                            base::BindOnce(&DataPipeIterator::ReadCallback,
+                                           weak_factory_.GetWeakPtr()));
+    handle_watcher_.Watch(
+        data_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+        base::BindRepeating(&DataPipeIterator::OnHandleReadable,
+                            weak_factory_.GetWeakPtr()));
+  }
+  ~DataPipeIterator() override = default;
+
+  v8::Local<v8::Promise> Next() {
+    gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+    v8::Local<v8::Promise> handle = promise.GetHandle();
+    if (pending_promise_) {
+      promise.RejectWithErrorMessage("Only one read can be pending at a time");
+      return handle;
+    }
+    if (failed_) {
+      promise.RejectWithErrorMessage("Could not get blob data");
+      return handle;
+    }
+    if (!data_pipe_) {
+      ResolveResult(std::move(promise), v8::Undefined(isolate_), true);
+      return handle;
+    }
+    pending_promise_ = std::move(promise);
+    if (!pipe_closed_)
+      handle_watcher_.ArmOrNotify();
+    return handle;
+  }
+
+  v8::Local<v8::Promise> Return() {
+    Close();
+    if (pending_promise_)
+      ResolveResult(std::move(*pending_promise_), v8::Undefined(isolate_),
+                    true);
+    pending_promise_.reset();
+    gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+    v8::Local<v8::Promise> handle = promise.GetHandle();
+    ResolveResult(std::move(promise), v8::Undefined(isolate_), true);
+    return handle;
+  }
+
+  // Callback invoked by DataPipeGetter::Read.
+  void ReadCallback(int32_t status, uint64_t size) {
+    if (status != net::OK) {
+      OnFailure();
+      return;
+    }
+    total_size_ = size;
+    if (bytes_read_ == size)
+      OnEnd();
+    else if (pipe_closed_)
+      OnFailure();
+  }
+
+  void OnHandleReadable(MojoResult result) {
+    if (!pending_promise_)
+      return;
+    if (result != MOJO_RESULT_OK) {
+      OnPipeClosed();
+      return;
+    }
+
+    uint32_t length = 0;
+    result = data_pipe_->ReadData(nullptr, &length, MOJO_READ_DATA_FLAG_QUERY);
+    if (result == MOJO_RESULT_OK && length == 0) {
+      handle_watcher_.ArmOrNotify();
+      return;
+    }
+    if (result != MOJO_RESULT_OK) {
+      OnPipeClosed();
+      return;
+    }
+
+    // Read straight into the memory of the Buffer handed to JS.
+    v8::Locker locker(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Object> buffer =
+        node::Buffer::New(isolate_, length).ToLocalChecked();
+    result = data_pipe_->ReadData(node::Buffer::Data(buffer), &length,
+                                  MOJO_READ_DATA_FLAG_ALL_OR_NONE);
+    if (result != MOJO_RESULT_OK) {
+      OnPipeClosed();
+      return;
+    }
+    bytes_read_ += length;
+    ResolveResult(std::move(*pending_promise_), buffer, false);
+    pending_promise_.reset();
+    if (total_size_ && bytes_read_ == *total_size_)
+      OnEnd();
+  }
+
+  // The producer closed the pipe, which is only expected once all data has
+  // been written.
+  void OnPipeClosed() {
+    if (!total_size_) {
+      // Wait for ReadCallback to tell whether everything was written.
+      pipe_closed_ = true;
+      handle_watcher_.Cancel();
+      return;
+    }
+    if (bytes_read_ == *total_size_)
+      OnEnd();
+    else
+      OnFailure();
+  }
+
+  void OnEnd() {
+    Close();
+    if (pending_promise_) {
+      ResolveResult(std::move(*pending_promise_), v8::Undefined(isolate_),
+                    true);
+      pending_promise_.reset();
+    }
+  }
+
+  void OnFailure() {
+    Close();
+    failed_ = true;
+    if (pending_promise_) {
+      pending_promise_->RejectWithErrorMessage("Could not get blob data");
+      pending_promise_.reset();
+    }
+  }
+
+  void Close() {
+    handle_watcher_.Cancel();
+    data_pipe_.reset();
+    data_pipe_getter_.reset();
+  }
+
+  void ResolveResult(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                     v8::Local<v8::Value> value,
+                     bool done) {
+    v8::Locker locker(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate_);
+    result.Set("value", value);
+    result.Set("done", done);
+    promise.Resolve(result.GetHandle());
+  }
+
+  v8::Isolate* isolate_;
+  mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter_;
+  mojo::ScopedDataPipeConsumerHandle data_pipe_;
+  mojo::SimpleWatcher handle_watcher_;
+
+  absl::optional<gin_helper::Promise<v8::Local<v8::Value>>> pending_promise_;
+  absl::optional<uint64_t> total_size_;
+  uint64_t bytes_read_ = 0;
+  bool pipe_closed_ = false;
+  bool failed_ = false;
+
+  base::WeakPtrFactory<DataPipeIterator> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(DataPipeIterator);
+};
+
+gin::WrapperInfo DataPipeIterator::kWrapperInfo = {gin::kEmbedderNativeGin};
+
 }  // namespace
 
 gin::WrapperInfo DataPipeHolder::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -165,6 +402,14 @@ v8::Local<v8::Promise> DataPipeHolder::ReadAll(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Value> DataPipeHolder::CreateIterator(v8::Isolate* isolate) {
+  if (!data_pipe_) {
+    gin_helper::ErrorThrower(isolate).ThrowError("Could not get blob data");
+    return v8::Undefined(isolate);
+  }
+  return DataPipeIterator::Create(isolate, std::move(data_pipe_)).ToV8();
+}
+
 // static
 gin::Handle<DataPipeHolder> DataPipeHolder::Create(
     v8::Isolate* isolate,
@@ -30,10 +30,13 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
 
   // Read all data at once.
   //
-  // TODO(zcbenz): This is apparently not suitable for really large data, but
-  // no one has complained about it yet.
+  // The whole body is held in memory, use CreateIterator() for large data.
   v8::Local<v8::Promise> ReadAll(v8::Isolate* isolate);
 
+  // Returns an async iterator that yields the data in chunks, only reading
+  // from the pipe when the next chunk is requested.
+  v8::Local<v8::Value> CreateIterator(v8::Isolate* isolate);
+
   // The unique ID that can be used to receive the object.
   const std::string& id() const { return id_; }
 
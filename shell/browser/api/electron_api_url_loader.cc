@@ -5,17 +5,23 @@
 #include "shell/browser/api/electron_api_url_loader.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/files/file.h"
+#include "base/macros.h"
 #include "base/no_destructor.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/string_data_source.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -25,12 +31,17 @@
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 
+#if defined(OS_WIN)
+#include <io.h>
+#endif
+
 namespace gin {
 
 template <>
@@ -74,25 +85,31 @@ namespace api {
 
 namespace {
 
-class BufferDataSource : public mojo::DataPipeProducer::DataSource {
+// Reads directly out of a JS ArrayBuffer's memory, which is kept alive until
+// the data has been written to the pipe.
+class BackingStoreDataSource : public mojo::DataPipeProducer::DataSource {
  public:
-  explicit BufferDataSource(base::span<char> buffer) {
-    buffer_.resize(buffer.size());
-    memcpy(buffer_.data(), buffer.data(), buffer_.size());
-  }
-  ~BufferDataSource() override = default;
+  BackingStoreDataSource(std::shared_ptr<v8::BackingStore> backing_store,
+                         size_t offset,
+                         size_t length)
+      : backing_store_(std::move(backing_store)),
+        offset_(offset),
+        length_(length) {}
+  ~BackingStoreDataSource() override = default;
 
  private:
   // mojo::DataPipeProducer::DataSource:
-  uint64_t GetLength() const override { return buffer_.size(); }
+  uint64_t GetLength() const override { return length_; }
   ReadResult Read(uint64_t offset, base::span<char> buffer) override {
     ReadResult result;
-    if (offset <= buffer_.size()) {
-      size_t readable_size = buffer_.size() - offset;
+    if (offset <= length_) {
+      size_t readable_size = length_ - offset;
       size_t writable_size = buffer.size();
       size_t copyable_size = std::min(readable_size, writable_size);
       if (copyable_size > 0) {
-        memcpy(buffer.data(), &buffer_[offset], copyable_size);
+        memcpy(buffer.data(),
+               static_cast<char*>(backing_store_->Data()) + offset_ + offset,
+               copyable_size);
       }
       result.bytes_read = copyable_size;
     } else {
@@ -102,9 +119,19 @@ class BufferDataSource : public mojo::DataPipeProducer::DataSource {
     return result;
   }
 
-  std::vector<char> buffer_;
+  std::shared_ptr<v8::BackingStore> backing_store_;
+  size_t offset_;
+  size_t length_;
 };
 
+// How many bytes of an upload body may be queued for the network before
+// write() stops resolving immediately. Chunks whose write() resolved early are
+// copied, since the caller is then free to reuse the buffer.
+constexpr size_t kMaxBufferedUploadBytes = 1024 * 1024;
+
+// Upper bound for the bufferSize option, larger values are clamped to it.
+constexpr int kMaxResponseBufferSize = 16 * 1024 * 1024;
+
 class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
                                 public network::mojom::ChunkedDataPipeGetter {
  public:
@@ -175,42 +202,77 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
       promise.RejectWithErrorMessage("Expected an ArrayBufferView");
       return handle;
     }
-    if (is_writing_) {
-      promise.RejectWithErrorMessage("Only one write can be pending at a time");
-      return handle;
-    }
     if (!size_callback_) {
       promise.RejectWithErrorMessage("Can't write after calling done()");
       return handle;
     }
     auto buffer = buffer_val.As<v8::ArrayBufferView>();
+    size_t length = buffer->ByteLength();
+    bytes_written_ += length;
+    buffered_bytes_ += length;
+    PendingWrite write;
+    write.length = length;
+    // Several chunks may be in flight at once, the caller is only held back
+    // once too much data is waiting to be written. A held back chunk is read
+    // in place and its promise resolves once it has been written.
+    if (buffered_bytes_ <= kMaxBufferedUploadBytes) {
+      const char* data =
+          static_cast<const char*>(buffer->Buffer()->GetBackingStore()->Data());
+      write.source = std::make_unique<mojo::StringDataSource>(
+          base::StringPiece(data + buffer->ByteOffset(), length),
+          mojo::StringDataSource::AsyncWritingMode::
+              STRING_MAY_BE_INVALIDATED_BEFORE_COMPLETION);
+      promise.Resolve();
+    } else {
+      write.source = std::make_unique<BackingStoreDataSource>(
+          buffer->Buffer()->GetBackingStore(), buffer->ByteOffset(), length);
+      write.promise = std::move(promise);
+    }
+    pending_writes_.push(std::move(write));
+    if (!is_writing_)
+      WriteNextChunk();
+    return handle;
+  }
+
+  void WriteNextChunk() {
+    if (pending_writes_.empty())
+      return;
+    PendingWrite write = std::move(pending_writes_.front());
+    pending_writes_.pop();
     is_writing_ = true;
-    bytes_written_ += buffer->ByteLength();
-    auto backing_store = buffer->Buffer()->GetBackingStore();
-    auto buffer_span = base::make_span(
-        static_cast<char*>(backing_store->Data()) + buffer->ByteOffset(),
-        buffer->ByteLength());
-    auto buffer_source = std::make_unique<BufferDataSource>(buffer_span);
+    writing_promise_ = std::move(write.promise);
     data_producer_->Write(
-        std::move(buffer_source),
+        std::move(write.source),
         base::BindOnce(&JSChunkedDataPipeGetter::OnWriteChunkComplete,
                        // We're OK to use Unretained here because we own
                        // |data_producer_|.
-                       base::Unretained(this), std::move(promise)));
-    return handle;
+                       base::Unretained(this), write.length));
   }
 
-  void OnWriteChunkComplete(gin_helper::Promise<void> promise,
-                            MojoResult result) {
+  void OnWriteChunkComplete(size_t length, MojoResult result) {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     is_writing_ = false;
-    if (result == MOJO_RESULT_OK) {
-      promise.Resolve();
-    } else {
-      promise.RejectWithErrorMessage("mojo result not ok: " +
-                                     std::to_string(result));
+    buffered_bytes_ -= length;
+    absl::optional<gin_helper::Promise<void>> promise =
+        std::move(writing_promise_);
+    writing_promise_.reset();
+    if (result != MOJO_RESULT_OK) {
+      std::string message = "mojo result not ok: " + std::to_string(result);
+      if (promise)
+        promise->RejectWithErrorMessage(message);
+      for (; !pending_writes_.empty(); pending_writes_.pop()) {
+        if (pending_writes_.front().promise)
+          pending_writes_.front().promise->RejectWithErrorMessage(message);
+      }
       Finished();
+      return;
     }
+    if (promise)
+      promise->Resolve();
+    WriteNextChunk();
+    // done() was called while writes were still queued.
+    if (!is_writing_ && !size_callback_)
+      Finished();
   }
 
   // TODO(nornagon): accept a net error here to allow the data provider to
@@ -218,7 +280,8 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
   void Done() {
     if (size_callback_) {
       std::move(size_callback_).Run(net::OK, bytes_written_);
-      Finished();
+      if (!is_writing_)
+        Finished();
     }
   }
 
@@ -227,12 +290,23 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
     data_producer_.reset();
     receiver_.reset();
     size_callback_.Reset();
+    pending_writes_ = {};
   }
 
   GetSizeCallback size_callback_;
   mojo::Receiver<network::mojom::ChunkedDataPipeGetter> receiver_{this};
   std::unique_ptr<mojo::DataPipeProducer> data_producer_;
+  struct PendingWrite {
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> source;
+    size_t length = 0;
+    // Set when write() is waiting for this chunk to be written.
+    absl::optional<gin_helper::Promise<void>> promise;
+  };
+
+  std::queue<PendingWrite> pending_writes_;
+  absl::optional<gin_helper::Promise<void>> writing_promise_;
   bool is_writing_ = false;
+  size_t buffered_bytes_ = 0;
   uint64_t bytes_written_ = 0;
 
   v8::Isolate* isolate_;
@@ -242,6 +316,23 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
 gin::WrapperInfo JSChunkedDataPipeGetter::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
+// Returns a duplicate of the file descriptor |fd|, leaving |fd| itself owned by
+// its caller.
+base::File DuplicateFileDescriptor(int fd) {
+#if defined(OS_WIN)
+  base::PlatformFile platform_file =
+      reinterpret_cast<base::PlatformFile>(_get_osfhandle(fd));
+#else
+  base::PlatformFile platform_file = fd;
+#endif
+  base::File borrowed(platform_file);
+  if (!borrowed.IsValid())
+    return base::File();
+  base::File file = borrowed.Duplicate();
+  ignore_result(borrowed.TakePlatformFile());
+  return file;
+}
+
 const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
     net::DefineNetworkTrafficAnnotation("electron_net_module", R"(
         semantics {
@@ -267,7 +358,10 @@ gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     std::unique_ptr<network::ResourceRequest> request,
     network::mojom::URLLoaderFactory* url_loader_factory,
-    int options) {
+    int options,
+    size_t buffer_size,
+    const base::FilePath& save_path)
+    : buffer_size_(buffer_size) {
   if (!request->trusted_params)
     request->trusted_params = network::ResourceRequest::TrustedParams();
   mojo::PendingRemote<network::mojom::URLLoaderNetworkServiceObserver>
@@ -298,7 +392,17 @@ SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
   loader_->SetOnDownloadProgressCallback(base::BindRepeating(
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
-  loader_->DownloadAsStream(url_loader_factory, this);
+  if (save_path.empty()) {
+    loader_->DownloadAsStream(url_loader_factory, this);
+  } else {
+    // The body is written to disk on a background sequence and never enters
+    // JS.
+    loader_->DownloadToFile(
+        url_loader_factory,
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        save_path);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -376,6 +480,10 @@ void SimpleURLLoaderWrapper::Clone(
 
 void SimpleURLLoaderWrapper::Cancel() {
   loader_.reset();
+  pending_chunk_ = base::StringPiece();
+  loader_resume_.Reset();
+  buffer_.reset();
+  buffer_used_ = 0;
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
   // This ensures that no further callbacks will be called, so there's no need
@@ -519,6 +627,45 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     }
   }
 
+  int buffer_size = 0;
+  if (opts.Get("bufferSize", &buffer_size)) {
+    if (buffer_size <= 0) {
+      args->ThrowTypeError("bufferSize must be a positive number");
+      return gin::Handle<SimpleURLLoaderWrapper>();
+    }
+    buffer_size = std::min(buffer_size, kMaxResponseBufferSize);
+  }
+  base::FilePath save_path;
+  opts.Get("savePath", &save_path);
+
+  v8::Local<v8::Value> upload_file;
+  if (opts.Get("uploadFile", &upload_file) &&
+      !upload_file->IsNullOrUndefined()) {
+    // The network service reads the file itself, so the body never passes
+    // through JS.
+    request->request_body =
+        base::MakeRefCounted<network::ResourceRequestBody>();
+    int fd;
+    base::FilePath path;
+    if (upload_file->IsNumber() &&
+        gin::ConvertFromV8(args->isolate(), upload_file, &fd)) {
+      base::File file = DuplicateFileDescriptor(fd);
+      if (!file.IsValid()) {
+        args->ThrowTypeError("Invalid file descriptor");
+        return gin::Handle<SimpleURLLoaderWrapper>();
+      }
+      request->request_body->AppendRawFileRange(
+          std::move(file), base::FilePath(), 0,
+          std::numeric_limits<uint64_t>::max(), base::Time());
+    } else if (gin::ConvertFromV8(args->isolate(), upload_file, &path)) {
+      request->request_body->AppendFileRange(
+          path, 0, std::numeric_limits<uint64_t>::max(), base::Time());
+    } else {
+      args->ThrowTypeError("uploadFile must be a path or a file descriptor");
+      return gin::Handle<SimpleURLLoaderWrapper>();
+    }
+  }
+
   std::string partition;
   gin::Handle<Session> session;
   if (!opts.Get("session", &session)) {
@@ -533,7 +680,7 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
   auto ret = gin::CreateHandle(
       args->isolate(),
       new SimpleURLLoaderWrapper(std::move(request), url_loader_factory.get(),
-                                 options));
+                                 options, buffer_size, save_path));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -544,6 +691,12 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
                                             base::OnceClosure resume) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (buffer_size_) {
+    pending_chunk_ = string_piece;
+    loader_resume_ = std::move(resume);
+    DrainPendingChunk();
+    return;
+  }
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
@@ -553,7 +706,90 @@ void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
        base::AdaptCallbackForRepeating(std::move(resume)));
 }
 
+void SimpleURLLoaderWrapper::DrainPendingChunk() {
+  if (draining_)
+    return;
+  draining_ = true;
+  while (!pending_chunk_.empty()) {
+    if (!buffer_)
+      buffer_.reset(new char[buffer_size_]);
+    size_t size = std::min(buffer_size_ - buffer_used_, pending_chunk_.size());
+    memcpy(buffer_.get() + buffer_used_, pending_chunk_.data(), size);
+    buffer_used_ += size;
+    pending_chunk_.remove_prefix(size);
+    if (buffer_used_ == buffer_size_) {
+      if (js_paused_) {
+        // Hold on to the rest of the chunk, and to the loader, until JS has
+        // caught up.
+        draining_ = false;
+        return;
+      }
+      EmitBufferedData();
+      // JS may have cancelled the request from its "data" handler.
+      if (!loader_) {
+        draining_ = false;
+        return;
+      }
+    }
+  }
+  draining_ = false;
+  // Whatever did not fill a whole buffer is handed over once the data that is
+  // already waiting in the pipe has been read.
+  if (buffer_used_ && !flush_scheduled_) {
+    flush_scheduled_ = true;
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&SimpleURLLoaderWrapper::FlushBufferedData,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  if (loader_resume_)
+    std::move(loader_resume_).Run();
+}
+
+void SimpleURLLoaderWrapper::EmitBufferedData() {
+  DCHECK(buffer_used_);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  // Hand the filled buffer to V8 as-is instead of copying it into a freshly
+  // allocated (and zeroed) ArrayBuffer.
+  char* data = buffer_.release();
+  auto backing_store = v8::ArrayBuffer::NewBackingStore(
+      data, buffer_used_,
+      [](void* data, size_t length, void* deleter_data) {
+        delete[] static_cast<char*>(data);
+      },
+      nullptr);
+  buffer_used_ = 0;
+  auto array_buffer = v8::ArrayBuffer::New(isolate, std::move(backing_store));
+  js_paused_ = true;
+  Emit("data", array_buffer,
+       base::BindRepeating(&SimpleURLLoaderWrapper::OnJSResume,
+                           weak_factory_.GetWeakPtr()));
+}
+
+void SimpleURLLoaderWrapper::FlushBufferedData() {
+  flush_scheduled_ = false;
+  if (!loader_ || !buffer_used_ || js_paused_)
+    return;
+  EmitBufferedData();
+}
+
+void SimpleURLLoaderWrapper::OnJSResume() {
+  if (!js_paused_)
+    return;
+  js_paused_ = false;
+  if (!loader_)
+    return;
+  if (!pending_chunk_.empty() || loader_resume_)
+    DrainPendingChunk();
+  else if (buffer_used_)
+    FlushBufferedData();
+}
+
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
+  if (success && buffer_used_) {
+    // The response is done, so there's no loader left to throttle.
+    EmitBufferedData();
+  }
   if (success) {
     Emit("complete");
   } else {
@@ -564,6 +800,17 @@ void SimpleURLLoaderWrapper::OnComplete(bool success) {
   pinned_chunk_pipe_getter_.Reset();
 }
 
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  if (!path.empty()) {
+    Emit("complete");
+  } else {
+    Emit("error", net::ErrorToString(loader_->NetError()));
+  }
+  loader_.reset();
+  pinned_wrapper_.Reset();
+  pinned_chunk_pipe_getter_.Reset();
+}
+
 void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
 
 void SimpleURLLoaderWrapper::OnResponseStarted(
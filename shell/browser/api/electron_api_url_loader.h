@@ -9,7 +9,9 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "net/base/auth.h"
@@ -58,7 +60,9 @@ class SimpleURLLoaderWrapper
  private:
   SimpleURLLoaderWrapper(std::unique_ptr<network::ResourceRequest> request,
                          network::mojom::URLLoaderFactory* url_loader_factory,
-                         int options);
+                         int options,
+                         size_t buffer_size,
+                         const base::FilePath& save_path);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -107,6 +111,13 @@ class SimpleURLLoaderWrapper
                   std::vector<std::string>* removed_headers);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnDownloadedToFile(base::FilePath path);
+
+  // Response body coalescing, used when a |buffer_size_| was requested.
+  void DrainPendingChunk();
+  void EmitBufferedData();
+  void FlushBufferedData();
+  void OnJSResume();
 
   void Start();
   void Pin();
@@ -116,6 +127,20 @@ class SimpleURLLoaderWrapper
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
+  // When non-zero, response chunks are copied into buffers of this size and
+  // only handed to JS once a buffer fills up, or once the network has no more
+  // data ready.
+  size_t buffer_size_ = 0;
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_used_ = 0;
+  // The chunk SimpleURLLoader gave us and the closure that asks it for more.
+  // The chunk stays valid until |loader_resume_| is run.
+  base::StringPiece pending_chunk_;
+  base::OnceClosure loader_resume_;
+  bool js_paused_ = false;
+  bool draining_ = false;
+  bool flush_scheduled_ = false;
+
   mojo::ReceiverSet<network::mojom::URLLoaderNetworkServiceObserver>
       url_loader_network_observer_receivers_;
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
@@ -900,8 +900,7 @@ void WebContents::InitWithWebContents(content::WebContents* web_contents,
 
   // Determine whether the WebContents is offscreen.
   auto* web_preferences = WebContentsPreferences::From(web_contents);
-  offscreen_ =
-      web_preferences && web_preferences->IsEnabled(options::kOffscreen);
+  offscreen_ = web_preferences && web_preferences->parsed().offscreen;
 
   // Create InspectableWebContents.
   inspectable_web_contents_.reset(new InspectableWebContents(
@@ -1185,8 +1184,7 @@ bool WebContents::PlatformHandleKeyboardEvent(
 
   // Check if the webContents has preferences and to ignore shortcuts
   auto* web_preferences = WebContentsPreferences::From(source);
-  if (web_preferences &&
-      web_preferences->IsEnabled("ignoreMenuShortcuts", false))
+  if (web_preferences && web_preferences->parsed().ignore_menu_shortcuts)
     return false;
 
   // Let the NativeWindow handle other parts.
@@ -1369,10 +1367,9 @@ void WebContents::HandleNewRenderFrame(
   // Set the background color of RenderWidgetHostView.
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   if (web_preferences) {
-    std::string color_name;
-    if (web_preferences->GetPreference(options::kBackgroundColor,
-                                       &color_name)) {
-      rwhv->SetBackgroundColor(ParseHexColor(color_name));
+    const auto& color_name = web_preferences->parsed().background_color;
+    if (color_name) {
+      rwhv->SetBackgroundColor(ParseHexColor(*color_name));
     } else {
       rwhv->SetBackgroundColor(SK_ColorTRANSPARENT);
     }
@@ -1506,8 +1503,7 @@ void WebContents::DidStartLoading() {
 
 void WebContents::DidStopLoading() {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
-  if (web_preferences &&
-      web_preferences->IsEnabled(options::kEnablePreferredSizeMode))
+  if (web_preferences && web_preferences->parsed().enable_preferred_size_mode)
     web_contents()->GetRenderViewHost()->EnablePreferredSizeMode();
 
   Emit("did-stop-loading");
@@ -2331,8 +2327,7 @@ void WebContents::InspectServiceWorker() {
 void WebContents::SetIgnoreMenuShortcuts(bool ignore) {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   DCHECK(web_preferences);
-  web_preferences->preference()->SetKey("ignoreMenuShortcuts",
-                                        base::Value(ignore));
+  web_preferences->SetIgnoreMenuShortcuts(ignore);
 }
 
 void WebContents::SetAudioMuted(bool muted) {
@@ -2566,12 +2561,15 @@ void WebContents::Print(gin::Arguments* args) {
                      std::move(callback), device_name, silent));
 }
 
-v8::Local<v8::Promise> WebContents::PrintToPDF(base::DictionaryValue settings) {
+v8::Local<v8::Promise> WebContents::PrintToPDF(
+    base::DictionaryValue settings,
+    absl::optional<base::FilePath> path) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
   PrintPreviewMessageHandler::FromWebContents(web_contents())
-      ->PrintToPDF(std::move(settings), std::move(promise));
+      ->PrintToPDF(std::move(settings), path.value_or(base::FilePath()),
+                   std::move(promise));
   return handle;
 }
 #endif
@@ -2966,6 +2964,87 @@ int WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+void WebContents::OnVideoFrame(std::unique_ptr<OffScreenVideoFrame> frame) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // Every plane is exposed as a Buffer over the captured memory. Each backing
+  // store holds a reference to the frame, and the buffers are detached once
+  // the listeners return so the capturer can recycle the memory right away.
+  using SharedFrame = std::shared_ptr<OffScreenVideoFrame>;
+  SharedFrame shared_frame(std::move(frame));
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  std::vector<v8::Local<v8::Value>> planes;
+  for (const auto& plane : shared_frame->planes) {
+    auto backing_store = v8::ArrayBuffer::NewBackingStore(
+        const_cast<uint8_t*>(plane.data), plane.size,
+        [](void* data, size_t length, void* deleter_data) {
+          delete static_cast<SharedFrame*>(deleter_data);
+        },
+        new SharedFrame(shared_frame));
+    auto array_buffer = v8::ArrayBuffer::New(isolate, std::move(backing_store));
+    array_buffers.push_back(array_buffer);
+
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("data", node::Buffer::New(isolate, array_buffer, 0, plane.size)
+                         .ToLocalChecked());
+    dict.Set("stride", plane.stride);
+    planes.push_back(dict.GetHandle());
+  }
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("format", shared_frame->format == media::PIXEL_FORMAT_NV12
+                         ? "nv12"
+                         : "i420");
+  dict.Set("codedSize", shared_frame->coded_size);
+  dict.Set("visibleRect", shared_frame->visible_rect);
+  dict.Set("updateRect", shared_frame->update_rect);
+  dict.Set("timestamp", shared_frame->timestamp.InMillisecondsF());
+  dict.Set("colorSpace", shared_frame->color_space);
+  dict.Set("planes", planes);
+  shared_frame.reset();
+
+  Emit("video-frame", dict.GetHandle());
+
+  for (auto array_buffer : array_buffers)
+    array_buffer->Detach();
+}
+
+void WebContents::SetOffscreenVideoFormat(gin_helper::ErrorThrower thrower,
+                                          const std::string& format) {
+  media::VideoPixelFormat pixel_format;
+  if (format == "argb") {
+    pixel_format = media::PIXEL_FORMAT_ARGB;
+  } else if (format == "i420") {
+    pixel_format = media::PIXEL_FORMAT_I420;
+  } else if (format == "nv12") {
+    pixel_format = media::PIXEL_FORMAT_NV12;
+  } else {
+    thrower.ThrowError("Invalid offscreen video format: " + format);
+    return;
+  }
+
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SetVideoFormat(
+        pixel_format, base::BindRepeating(&WebContents::OnVideoFrame,
+                                          base::Unretained(this)));
+}
+
+std::string WebContents::GetOffscreenVideoFormat() const {
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (!osr_wcv)
+    return "argb";
+  switch (osr_wcv->GetVideoFormat()) {
+    case media::PIXEL_FORMAT_I420:
+      return "i420";
+    case media::PIXEL_FORMAT_NV12:
+      return "nv12";
+    default:
+      return "argb";
+  }
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -3544,9 +3623,9 @@ void WebContents::SetHtmlApiFullscreen(bool enter_fullscreen) {
   // Set fullscreen on window if allowed.
   auto* web_preferences = WebContentsPreferences::From(GetWebContents());
   bool html_fullscreenable =
-      web_preferences ? !web_preferences->IsEnabled(
-                            options::kDisableHtmlFullscreenWindowResize)
-                      : true;
+      web_preferences
+          ? !web_preferences->parsed().disable_html_fullscreen_window_resize
+          : true;
 
   if (html_fullscreenable) {
     owner_window_->SetFullScreen(enter_fullscreen);
@@ -3647,6 +3726,10 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
       .SetMethod("isPainting", &WebContents::IsPainting)
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
+      .SetMethod("setOffscreenVideoFormat",
+                 &WebContents::SetOffscreenVideoFormat)
+      .SetMethod("getOffscreenVideoFormat",
+                 &WebContents::GetOffscreenVideoFormat)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
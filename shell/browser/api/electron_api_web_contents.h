@@ -40,6 +40,7 @@
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "ui/gfx/image/image.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
@@ -85,6 +86,7 @@ class NativeWindow;
 #if BUILDFLAG(ENABLE_OSR)
 class OffScreenRenderWidgetHostView;
 class OffScreenWebContentsView;
+struct OffScreenVideoFrame;
 #endif
 
 namespace api {
@@ -215,7 +217,8 @@ class WebContents : public gin::Wrappable<WebContents>,
                            std::u16string default_printer);
   void Print(gin::Arguments* args);
   // Print current page as PDF.
-  v8::Local<v8::Promise> PrintToPDF(base::DictionaryValue settings);
+  v8::Local<v8::Promise> PrintToPDF(base::DictionaryValue settings,
+                                    absl::optional<base::FilePath> path);
 #endif
 
   void SetNextChildWebPreferences(const gin_helper::Dictionary);
@@ -274,6 +277,10 @@ class WebContents : public gin::Wrappable<WebContents>,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void OnVideoFrame(std::unique_ptr<OffScreenVideoFrame> frame);
+  void SetOffscreenVideoFormat(gin_helper::ErrorThrower thrower,
+                               const std::string& format);
+  std::string GetOffscreenVideoFormat() const;
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
@@ -15,6 +15,7 @@
 #include "content/public/browser/render_frame_host.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/object_template_builder.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
@@ -101,7 +102,7 @@ bool WebFrameMain::CheckRenderFrame() const {
 v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScript(
     gin::Arguments* args,
     const std::u16string& code) {
-  gin_helper::Promise<base::Value> promise(args->isolate());
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
   // Optional userGesture parameter
@@ -130,14 +131,36 @@ v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScript(
         blink::mojom::UserActivationNotificationType::kTest);
   }
 
-  render_frame_->ExecuteJavaScriptForTests(
-      code, base::BindOnce([](gin_helper::Promise<base::Value> promise,
-                              base::Value value) { promise.Resolve(value); },
-                           std::move(promise)));
+  // The result comes back serialized by the V8 value serializer so that it is
+  // cloned as faithfully as postMessage() would, without a base::Value round
+  // trip.
+  GetRendererApi()->ExecuteJavaScript(
+      code, user_gesture,
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(&WebFrameMain::OnJavaScriptResult, std::move(promise)),
+          blink::CloneableMessage(),
+          absl::optional<std::string>(
+              "Render frame was disposed before the script could run")));
 
   return handle;
 }
 
+// static
+void WebFrameMain::OnJavaScriptResult(
+    gin_helper::Promise<v8::Local<v8::Value>> promise,
+    blink::CloneableMessage result,
+    const absl::optional<std::string>& error) {
+  if (error) {
+    promise.RejectWithErrorMessage(*error);
+    return;
+  }
+
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(DeserializeV8Value(isolate, result));
+}
+
 bool WebFrameMain::Reload() {
   if (!CheckRenderFrame())
     return false;
@@ -162,6 +185,31 @@ void WebFrameMain::Send(v8::Isolate* isolate,
                             0 /* sender_id */);
 }
 
+// static
+void WebFrameMain::Broadcast(v8::Isolate* isolate,
+                             const std::vector<WebFrameMain*>& frames,
+                             bool internal,
+                             const std::string& channel,
+                             v8::Local<v8::Value> args) {
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate, args, &message)) {
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Failed to serialize arguments")));
+    return;
+  }
+
+  for (auto* frame : frames) {
+    // Frames that went away since they were collected are skipped rather
+    // than failing the whole broadcast.
+    if (frame->render_frame_disposed_)
+      continue;
+    // The clones only reference the bytes encoded above, each one is copied
+    // straight into its mojo message when sent.
+    frame->GetRendererApi()->Message(internal, channel, message.ShallowClone(),
+                                     0 /* sender_id */);
+  }
+}
+
 const mojo::Remote<mojom::ElectronRenderer>& WebFrameMain::GetRendererApi() {
   if (!renderer_api_) {
     pending_receiver_ = renderer_api_.BindNewPipeAndPassReceiver();
@@ -379,6 +427,19 @@ namespace {
 
 using electron::api::WebFrameMain;
 
+void Broadcast(gin_helper::ErrorThrower thrower,
+               v8::Local<v8::Value> frames_value,
+               bool internal,
+               const std::string& channel,
+               v8::Local<v8::Value> args) {
+  std::vector<WebFrameMain*> frames;
+  if (!gin::ConvertFromV8(thrower.isolate(), frames_value, &frames)) {
+    thrower.ThrowTypeError("frames must be an array of WebFrameMain");
+    return;
+  }
+  WebFrameMain::Broadcast(thrower.isolate(), frames, internal, channel, args);
+}
+
 v8::Local<v8::Value> FromID(gin_helper::ErrorThrower thrower,
                             int render_process_id,
                             int render_frame_id) {
@@ -400,6 +461,7 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("WebFrameMain", WebFrameMain::GetConstructor(context));
   dict.SetMethod("fromId", &FromID);
+  dict.SetMethod("_broadcast", &Broadcast);
 }
 
 }  // namespace
@@ -15,6 +15,9 @@
 #include "mojo/public/cpp/bindings/remote.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/pinnable.h"
+#include "shell/common/gin_helper/promise.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
 #include "third_party/blink/public/mojom/page/page_visibility_state.mojom-forward.h"
 
 class GURL;
@@ -55,6 +58,13 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
   static void RenderFrameDeleted(content::RenderFrameHost* rfh);
   static void RenderFrameCreated(content::RenderFrameHost* rfh);
 
+  // Sends the same message to all |frames|, serializing |args| only once.
+  static void Broadcast(v8::Isolate* isolate,
+                        const std::vector<WebFrameMain*>& frames,
+                        bool internal,
+                        const std::string& channel,
+                        v8::Local<v8::Value> args);
+
   // Mark RenderFrameHost as disposed and to no longer access it. This can
   // occur upon frame navigation.
   void MarkRenderFrameDisposed();
@@ -80,6 +90,10 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
 
   v8::Local<v8::Promise> ExecuteJavaScript(gin::Arguments* args,
                                            const std::u16string& code);
+  static void OnJavaScriptResult(
+      gin_helper::Promise<v8::Local<v8::Value>> promise,
+      blink::CloneableMessage result,
+      const absl::optional<std::string>& error);
   bool Reload();
   void Send(v8::Isolate* isolate,
             bool internal,
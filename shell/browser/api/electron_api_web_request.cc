@@ -9,12 +9,15 @@
 #include <utility>
 
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "base/values.h"
 #include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "gin/converter.h"
 #include "gin/dictionary.h"
+#include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "net/http/http_content_disposition.h"
+#include "net/http/http_util.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
@@ -94,15 +97,39 @@ struct UserData : public base::SupportsUserData::Data {
 
 // Test whether the URL of |request| matches |patterns|.
 bool MatchesFilterCondition(extensions::WebRequestInfo* info,
-                            const std::set<URLPattern>& patterns) {
-  if (patterns.empty())
-    return true;
-
-  for (const auto& pattern : patterns) {
-    if (pattern.MatchesURL(info->url))
-      return true;
+                            const URLPatternMatcher& patterns) {
+  return patterns.empty() || patterns.MatchesURL(info->url);
+}
+
+// Reads the header changes of a rule, where a string value sets the header
+// and null removes it.
+bool ReadHeaderChanges(const base::Value& value,
+                       std::vector<std::pair<std::string,
+                                             absl::optional<std::string>>>* out,
+                       std::string* error) {
+  if (!value.is_dict()) {
+    *error = "Header changes must be an object";
+    return false;
   }
-  return false;
+  for (const auto& it : value.DictItems()) {
+    if (!net::HttpUtil::IsValidHeaderName(it.first)) {
+      *error = "Invalid header name '" + it.first + "'";
+      return false;
+    }
+    if (it.second.is_string()) {
+      if (!net::HttpUtil::IsValidHeaderValue(it.second.GetString())) {
+        *error = "Invalid value for header '" + it.first + "'";
+        return false;
+      }
+      out->emplace_back(it.first, it.second.GetString());
+    } else if (it.second.is_none()) {
+      out->emplace_back(it.first, absl::nullopt);
+    } else {
+      *error = "Header '" + it.first + "' must be a string or null";
+      return false;
+    }
+  }
+  return true;
 }
 
 // Convert HttpResponseHeaders to V8.
@@ -141,8 +168,92 @@ v8::Local<v8::Value> HttpResponseHeadersToV8(
   return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
 }
 
+// Native state behind the lazily materialized properties of a details object.
+//
+// Converting headers, upload data and frames to V8 is far more expensive than
+// the rest of the details while most listeners never read them, so these are
+// installed as lazy data properties that only convert on first access.  The
+// wrapper is the data of those properties and lives as long as they do.
+class LazyDetails : public gin::Wrappable<LazyDetails> {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  static gin::Handle<LazyDetails> Create(v8::Isolate* isolate) {
+    return gin::CreateHandle(isolate, new LazyDetails);
+  }
+
+  int render_process_id = -1;
+  int frame_id = -1;
+  scoped_refptr<net::HttpResponseHeaders> response_headers;
+  scoped_refptr<network::ResourceRequestBody> request_body;
+  net::HttpRequestHeaders request_headers;
+
+ private:
+  LazyDetails() = default;
+  ~LazyDetails() override = default;
+};
+
+gin::WrapperInfo LazyDetails::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+LazyDetails* LazyDetailsFromInfo(
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  LazyDetails* lazy = nullptr;
+  gin::ConvertFromV8(info.GetIsolate(), info.Data(), &lazy);
+  return lazy;
+}
+
+void GetLazyFrame(v8::Local<v8::Name> name,
+                  const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* lazy = LazyDetailsFromInfo(info);
+  if (!lazy)
+    return;
+  // The frame may have gone away if the property is read asynchronously.
+  auto* render_frame_host = content::RenderFrameHost::FromID(
+      lazy->render_process_id, lazy->frame_id);
+  info.GetReturnValue().Set(
+      gin::ConvertToV8(info.GetIsolate(), render_frame_host));
+}
+
+void GetLazyResponseHeaders(v8::Local<v8::Name> name,
+                            const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* lazy = LazyDetailsFromInfo(info);
+  if (lazy)
+    info.GetReturnValue().Set(
+        HttpResponseHeadersToV8(lazy->response_headers.get()));
+}
+
+void GetLazyUploadData(v8::Local<v8::Name> name,
+                       const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* lazy = LazyDetailsFromInfo(info);
+  if (lazy && lazy->request_body)
+    info.GetReturnValue().Set(
+        gin::ConvertToV8(info.GetIsolate(), *lazy->request_body));
+}
+
+void GetLazyRequestHeaders(v8::Local<v8::Name> name,
+                           const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* lazy = LazyDetailsFromInfo(info);
+  if (lazy)
+    info.GetReturnValue().Set(
+        gin::ConvertToV8(info.GetIsolate(), lazy->request_headers));
+}
+
+void SetLazyProperty(gin::Dictionary* details,
+                     const gin::Handle<LazyDetails>& lazy,
+                     const char* key,
+                     v8::AccessorNameGetterCallback getter) {
+  v8::Isolate* isolate = details->isolate();
+  gin::ConvertToV8(isolate, *details)
+      .As<v8::Object>()
+      ->SetLazyDataProperty(isolate->GetCurrentContext(),
+                            gin::StringToV8(isolate, key), getter, lazy.ToV8())
+      .Check();
+}
+
 // Overloaded by multiple types to fill the |details| object.
-void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
+void ToDictionary(gin::Dictionary* details,
+                  const gin::Handle<LazyDetails>& lazy,
+                  extensions::WebRequestInfo* info) {
   details->Set("id", info->id);
   details->Set("url", info->url);
   details->Set("method", info->method);
@@ -154,14 +265,16 @@ void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
     details->Set("fromCache", info->response_from_cache);
     details->Set("statusLine", info->response_headers->GetStatusLine());
     details->Set("statusCode", info->response_headers->response_code());
-    details->Set("responseHeaders",
-                 HttpResponseHeadersToV8(info->response_headers.get()));
+    lazy->response_headers = info->response_headers;
+    SetLazyProperty(details, lazy, "responseHeaders", &GetLazyResponseHeaders);
   }
 
   auto* render_frame_host =
       content::RenderFrameHost::FromID(info->render_process_id, info->frame_id);
   if (render_frame_host) {
-    details->Set("frame", render_frame_host);
+    lazy->render_process_id = info->render_process_id;
+    lazy->frame_id = info->frame_id;
+    SetLazyProperty(details, lazy, "frame", &GetLazyFrame);
     auto* web_contents =
         content::WebContents::FromRenderFrameHost(render_frame_host);
     auto* api_web_contents = WebContents::From(web_contents);
@@ -173,35 +286,49 @@ void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
 }
 
 void ToDictionary(gin::Dictionary* details,
+                  const gin::Handle<LazyDetails>& lazy,
                   const network::ResourceRequest& request) {
   details->Set("referrer", request.referrer);
-  if (request.request_body)
-    details->Set("uploadData", *request.request_body);
+  if (request.request_body) {
+    lazy->request_body = request.request_body;
+    SetLazyProperty(details, lazy, "uploadData", &GetLazyUploadData);
+  }
 }
 
 void ToDictionary(gin::Dictionary* details,
+                  const gin::Handle<LazyDetails>& lazy,
                   const net::HttpRequestHeaders& headers) {
-  details->Set("requestHeaders", headers);
+  lazy->request_headers = headers;
+  SetLazyProperty(details, lazy, "requestHeaders", &GetLazyRequestHeaders);
 }
 
-void ToDictionary(gin::Dictionary* details, const GURL& location) {
+void ToDictionary(gin::Dictionary* details,
+                  const gin::Handle<LazyDetails>& lazy,
+                  const GURL& location) {
   details->Set("redirectURL", location);
 }
 
-void ToDictionary(gin::Dictionary* details, int net_error) {
+void ToDictionary(gin::Dictionary* details,
+                  const gin::Handle<LazyDetails>& lazy,
+                  int net_error) {
   details->Set("error", net::ErrorToString(net_error));
 }
 
 // Helper function to fill |details| with arbitrary |args|.
 template <typename Arg>
-void FillDetails(gin::Dictionary* details, Arg arg) {
-  ToDictionary(details, arg);
+void FillDetails(gin::Dictionary* details,
+                 const gin::Handle<LazyDetails>& lazy,
+                 Arg arg) {
+  ToDictionary(details, lazy, arg);
 }
 
 template <typename Arg, typename... Args>
-void FillDetails(gin::Dictionary* details, Arg arg, Args... args) {
-  ToDictionary(details, arg);
-  FillDetails(details, args...);
+void FillDetails(gin::Dictionary* details,
+                 const gin::Handle<LazyDetails>& lazy,
+                 Arg arg,
+                 Args... args) {
+  ToDictionary(details, lazy, arg);
+  FillDetails(details, lazy, args...);
 }
 
 // Fill the native types with the result from the response object.
@@ -239,18 +366,31 @@ void ReadFromResponse(v8::Isolate* isolate,
 gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(
-    std::set<URLPattern> patterns_,
+    const std::set<URLPattern>& patterns_,
     SimpleListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(patterns_), listener(listener_) {}
 WebRequest::SimpleListenerInfo::SimpleListenerInfo() = default;
 WebRequest::SimpleListenerInfo::~SimpleListenerInfo() = default;
+WebRequest::SimpleListenerInfo::SimpleListenerInfo(SimpleListenerInfo&&) =
+    default;
+WebRequest::SimpleListenerInfo& WebRequest::SimpleListenerInfo::operator=(
+    SimpleListenerInfo&&) = default;
 
 WebRequest::ResponseListenerInfo::ResponseListenerInfo(
-    std::set<URLPattern> patterns_,
+    const std::set<URLPattern>& patterns_,
     ResponseListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(patterns_), listener(listener_) {}
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
+WebRequest::ResponseListenerInfo::ResponseListenerInfo(ResponseListenerInfo&&) =
+    default;
+WebRequest::ResponseListenerInfo& WebRequest::ResponseListenerInfo::operator=(
+    ResponseListenerInfo&&) = default;
+
+WebRequest::Rule::Rule() = default;
+WebRequest::Rule::~Rule() = default;
+WebRequest::Rule::Rule(Rule&&) = default;
+WebRequest::Rule& WebRequest::Rule::operator=(Rule&&) = default;
 
 WebRequest::WebRequest(v8::Isolate* isolate,
                        content::BrowserContext* browser_context)
@@ -284,7 +424,8 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<SimpleEvent::kOnErrorOccurred>)
       .SetMethod("onCompleted",
-                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>);
+                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>)
+      .SetMethod("setRules", &WebRequest::SetRules);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -292,13 +433,27 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           rules_.empty());
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  for (const auto& rule : rules_) {
+    if (!MatchesFilterCondition(info, rule.url_patterns))
+      continue;
+    if (rule.action == Rule::Action::kBlock)
+      return net::ERR_BLOCKED_BY_CLIENT;
+    // Skip redirects to the URL being requested, they would loop forever.
+    if (rule.action == Rule::Action::kRedirect &&
+        rule.redirect_url != info->url) {
+      *new_url = rule.redirect_url;
+      return net::OK;
+    }
+  }
+
   return HandleResponseEvent(ResponseEvent::kOnBeforeRequest, info,
                              std::move(callback), new_url, request);
 }
@@ -307,6 +462,18 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  for (const auto& rule : rules_) {
+    if (rule.request_headers.empty() ||
+        !MatchesFilterCondition(info, rule.url_patterns))
+      continue;
+    for (const auto& change : rule.request_headers) {
+      if (change.second)
+        headers->SetHeader(change.first, *change.second);
+      else
+        headers->RemoveHeader(change.first);
+    }
+  }
+
   return HandleResponseEvent(
       ResponseEvent::kOnBeforeSendHeaders, info,
       base::BindOnce(std::move(callback), std::set<std::string>(),
@@ -324,6 +491,24 @@ int WebRequest::OnHeadersReceived(
   const std::string& status_line =
       original_response_headers ? original_response_headers->GetStatusLine()
                                 : std::string();
+
+  for (const auto& rule : rules_) {
+    if (!original_response_headers || rule.response_headers.empty() ||
+        !MatchesFilterCondition(info, rule.url_patterns))
+      continue;
+    if (!*override_response_headers) {
+      *override_response_headers =
+          base::MakeRefCounted<net::HttpResponseHeaders>(
+              original_response_headers->raw_headers());
+    }
+    for (const auto& change : rule.response_headers) {
+      if (change.second)
+        (*override_response_headers)->SetHeader(change.first, *change.second);
+      else
+        (*override_response_headers)->RemoveHeader(change.first);
+    }
+  }
+
   return HandleResponseEvent(
       ResponseEvent::kOnHeadersReceived, info, std::move(callback),
       std::make_pair(override_response_headers, status_line), request);
@@ -421,10 +606,97 @@ void WebRequest::SetListener(Event event,
     return;
   }
 
+  bool had_listener = HasListener();
   if (listener.is_null())
     listeners->erase(event);
   else
-    (*listeners)[event] = {std::move(patterns), std::move(listener)};
+    (*listeners)[event] = {patterns, std::move(listener)};
+  OnListenersChanged(had_listener);
+}
+
+void WebRequest::SetRules(gin::Arguments* args) {
+  v8::Local<v8::Value> arg;
+  std::vector<v8::Local<v8::Value>> rule_values;
+  if (!args->GetNext(&arg) ||
+      !(arg->IsNull() ||
+        gin::ConvertFromV8(args->isolate(), arg, &rule_values))) {
+    args->ThrowTypeError("Must pass null or an Array of rules");
+    return;
+  }
+
+  std::vector<Rule> rules;
+  for (auto rule_value : rule_values) {
+    gin::Dictionary dict(args->isolate());
+    if (!gin::ConvertFromV8(args->isolate(), rule_value, &dict)) {
+      args->ThrowTypeError("Each rule must be an object");
+      return;
+    }
+
+    Rule rule;
+
+    // An empty pattern set matches every URL, so a "urls" value that can not
+    // be read must not silently turn into one.
+    std::set<std::string> filter_patterns;
+    v8::Local<v8::Value> urls;
+    if (dict.Get("urls", &urls) && !urls->IsUndefined() &&
+        !gin::ConvertFromV8(args->isolate(), urls, &filter_patterns)) {
+      args->ThrowTypeError("Rule property 'urls' must be an Array of strings");
+      return;
+    }
+    std::set<URLPattern> patterns;
+    for (const std::string& filter_pattern : filter_patterns) {
+      URLPattern pattern(URLPattern::SCHEME_ALL);
+      const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
+      if (result != URLPattern::ParseResult::kSuccess) {
+        const char* error_type = URLPattern::GetParseResultString(result);
+        args->ThrowTypeError("Invalid url pattern " + filter_pattern + ": " +
+                             error_type);
+        return;
+      }
+      patterns.insert(pattern);
+    }
+    rule.url_patterns = URLPatternMatcher(patterns);
+
+    std::string action;
+    dict.Get("action", &action);
+    if (action == "block") {
+      rule.action = Rule::Action::kBlock;
+    } else if (action == "redirect") {
+      rule.action = Rule::Action::kRedirect;
+      if (!dict.Get("redirectURL", &rule.redirect_url) ||
+          !rule.redirect_url.is_valid()) {
+        args->ThrowTypeError("Redirect rules must have a valid 'redirectURL'");
+        return;
+      }
+    } else if (action == "modifyHeaders") {
+      rule.action = Rule::Action::kModifyHeaders;
+      std::string error;
+      base::Value headers;
+      if ((dict.Get("requestHeaders", &headers) &&
+           !ReadHeaderChanges(headers, &rule.request_headers, &error)) ||
+          (dict.Get("responseHeaders", &headers) &&
+           !ReadHeaderChanges(headers, &rule.response_headers, &error))) {
+        args->ThrowTypeError(error);
+        return;
+      }
+    } else {
+      args->ThrowTypeError("Unknown rule action '" + action + "'");
+      return;
+    }
+    rules.push_back(std::move(rule));
+  }
+
+  bool had_listener = HasListener();
+  rules_ = std::move(rules);
+  OnListenersChanged(had_listener);
+}
+
+void WebRequest::OnListenersChanged(bool had_listener) {
+  // URLLoaderFactories created while there were no listeners are not proxied,
+  // have them re-created so the new listener sees every request.
+  if (!had_listener && HasListener())
+    static_cast<ElectronBrowserContext*>(browser_context_)
+        ->ResetURLLoaderFactories();
 }
 
 template <typename... Args>
@@ -442,7 +714,7 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   gin::Dictionary details(isolate, v8::Object::New(isolate));
-  FillDetails(&details, request_info, args...);
+  FillDetails(&details, LazyDetails::Create(isolate), request_info, args...);
   info.listener.Run(gin::ConvertToV8(isolate, details));
 }
 
@@ -465,7 +737,7 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   gin::Dictionary details(isolate, v8::Object::New(isolate));
-  FillDetails(&details, request_info, args...);
+  FillDetails(&details, LazyDetails::Create(isolate), request_info, args...);
 
   ResponseCallback response =
       base::BindOnce(&WebRequest::OnListenerResult<Out>, base::Unretained(this),
@@ -7,13 +7,18 @@
 
 #include <map>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "base/values.h"
 #include "extensions/common/url_pattern.h"
 #include "gin/arguments.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/net/url_pattern_matcher.h"
 #include "shell/browser/net/web_request_api_interface.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace content {
 class BrowserContext;
@@ -125,24 +130,59 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   template <typename T>
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
 
+  void SetRules(gin::Arguments* args);
+
+  // Called after listeners or rules change, |had_listener| is the value
+  // HasListener() returned before the change.
+  void OnListenersChanged(bool had_listener);
+
   struct SimpleListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternMatcher url_patterns;
     SimpleListener listener;
 
-    SimpleListenerInfo(std::set<URLPattern>, SimpleListener);
+    SimpleListenerInfo(const std::set<URLPattern>&, SimpleListener);
     SimpleListenerInfo();
     ~SimpleListenerInfo();
+    SimpleListenerInfo(SimpleListenerInfo&&);
+    SimpleListenerInfo& operator=(SimpleListenerInfo&&);
   };
 
   struct ResponseListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternMatcher url_patterns;
     ResponseListener listener;
 
-    ResponseListenerInfo(std::set<URLPattern>, ResponseListener);
+    ResponseListenerInfo(const std::set<URLPattern>&, ResponseListener);
     ResponseListenerInfo();
     ~ResponseListenerInfo();
+    ResponseListenerInfo(ResponseListenerInfo&&);
+    ResponseListenerInfo& operator=(ResponseListenerInfo&&);
+  };
+
+  // A declarative rule set with webRequest.setRules(), evaluated natively
+  // before any JS listener is invoked.
+  struct Rule {
+    enum class Action {
+      kBlock,
+      kRedirect,
+      kModifyHeaders,
+    };
+    // Header name => new value, or absl::nullopt to remove the header.
+    using HeaderChanges =
+        std::vector<std::pair<std::string, absl::optional<std::string>>>;
+
+    URLPatternMatcher url_patterns;
+    Action action = Action::kBlock;
+    GURL redirect_url;
+    HeaderChanges request_headers;
+    HeaderChanges response_headers;
+
+    Rule();
+    ~Rule();
+    Rule(Rule&&);
+    Rule& operator=(Rule&&);
   };
 
+  std::vector<Rule> rules_;
   std::map<SimpleEvent, SimpleListenerInfo> simple_listeners_;
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
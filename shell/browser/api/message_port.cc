@@ -4,11 +4,13 @@
 
 #include "shell/browser/api/message_port.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_set>
 #include <utility>
 
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "gin/arguments.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
@@ -29,6 +31,8 @@ gin::WrapperInfo MessagePort::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 MessagePort::MessagePort() = default;
 MessagePort::~MessagePort() {
+  // Messages can not be delivered once the wrapper is gone.
+  pending_messages_.clear();
   if (!IsNeutered()) {
     // Disentangle before teardown. The MessagePortDescriptor will blow up if it
     // hasn't had its underlying handle returned to it before teardown.
@@ -103,6 +107,9 @@ void MessagePort::Start() {
 void MessagePort::Close() {
   if (closed_)
     return;
+  // Messages that were read but not delivered yet are dropped, as if they were
+  // still queued on the closed port.
+  pending_messages_.clear();
   if (!IsNeutered()) {
     Disentangle().ReleaseHandle();
     blink::MessagePortDescriptorPair pipe;
@@ -131,8 +138,8 @@ void MessagePort::Entangle(blink::MessagePortDescriptor port) {
       base::ThreadTaskRunnerHandle::Get());
   connector_->PauseIncomingMethodCallProcessing();
   connector_->set_incoming_receiver(this);
-  connector_->set_connection_error_handler(
-      base::BindOnce(&MessagePort::Close, weak_factory_.GetWeakPtr()));
+  connector_->set_connection_error_handler(base::BindOnce(
+      &MessagePort::OnConnectionError, weak_factory_.GetWeakPtr()));
   if (HasPendingActivity())
     Pin();
 }
@@ -143,6 +150,8 @@ void MessagePort::Entangle(blink::MessagePortChannel channel) {
 
 blink::MessagePortChannel MessagePort::Disentangle() {
   DCHECK(!IsNeutered());
+  DCHECK(pending_messages_.empty());
+  paused_for_batch_ = false;
   port_.GiveDisentangledHandle(connector_->PassMessagePipe());
   connector_ = nullptr;
   if (!HasPendingActivity())
@@ -180,6 +189,13 @@ std::vector<blink::MessagePortChannel> MessagePort::DisentanglePorts(
   if (ports.empty())
     return std::vector<blink::MessagePortChannel>();
 
+  // Messages already read from a port's pipe can not travel with it, so they
+  // are delivered before the ports are checked and transferred.
+  for (const auto& port : ports) {
+    if (port.get())
+      port->FlushPendingMessages(true);
+  }
+
   std::unordered_set<MessagePort*> visited;
 
   // Walk the incoming array - if there are any duplicate ports, or null ports
@@ -232,31 +248,128 @@ bool MessagePort::Accept(mojo::Message* mojo_message) {
     return false;
   }
 
+  if (batching_) {
+    pending_messages_.push_back(std::move(message));
+    if (pending_messages_.size() >= max_batch_messages_ && !paused_for_batch_) {
+      // Leave further messages in the pipe until this batch is delivered.
+      paused_for_batch_ = true;
+      connector_->PauseIncomingMethodCallProcessing();
+    }
+    ScheduleFlush();
+    return true;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
 
-  auto ports = EntanglePorts(isolate, std::move(message.ports));
-
-  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, message);
+  v8::Local<v8::Value> event = CreateMessageEvent(isolate, std::move(message));
 
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
     return false;
 
-  auto event = gin::DataObjectBuilder(isolate)
-                   .Set("data", message_value)
-                   .Set("ports", ports)
-                   .Build();
   gin_helper::EmitEvent(isolate, self, "message", event);
   return true;
 }
 
+v8::Local<v8::Value> MessagePort::CreateMessageEvent(
+    v8::Isolate* isolate,
+    blink::TransferableMessage message) {
+  auto ports = EntanglePorts(isolate, std::move(message.ports));
+
+  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, message);
+
+  return gin::DataObjectBuilder(isolate)
+      .Set("data", message_value)
+      .Set("ports", ports)
+      .Build();
+}
+
+void MessagePort::EnableBatching(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    int max_messages = max_batch_messages_;
+    if (options.Get("maxMessages", &max_messages) && max_messages <= 0) {
+      args->ThrowTypeError("maxMessages must be a positive integer");
+      return;
+    }
+    double max_duration = max_batch_duration_.InMillisecondsF();
+    if (options.Get("maxDuration", &max_duration) && max_duration <= 0) {
+      args->ThrowTypeError("maxDuration must be a positive number");
+      return;
+    }
+    max_batch_messages_ = max_messages;
+    max_batch_duration_ = base::TimeDelta::FromMillisecondsD(max_duration);
+  }
+  batching_ = true;
+}
+
+void MessagePort::ScheduleFlush() {
+  if (flush_scheduled_)
+    return;
+  flush_scheduled_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&MessagePort::FlushPendingMessages,
+                                weak_factory_.GetWeakPtr(), false));
+}
+
+void MessagePort::FlushPendingMessages(bool drain) {
+  if (!drain)
+    flush_scheduled_ = false;
+  if (pending_messages_.empty())
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self)) {
+    pending_messages_.clear();
+    return;
+  }
+
+  // The events are prepared up front so that the whole batch enters JS once.
+  size_t limit =
+      drain ? pending_messages_.size()
+            : std::min(pending_messages_.size(), max_batch_messages_);
+  const base::TimeTicks deadline = base::TimeTicks::Now() + max_batch_duration_;
+  std::vector<v8::Local<v8::Value>> events;
+  events.reserve(limit);
+  for (size_t i = 0; i < limit; ++i) {
+    events.push_back(
+        CreateMessageEvent(isolate, std::move(pending_messages_[i])));
+    if (!drain && base::TimeTicks::Now() >= deadline)
+      break;
+  }
+  pending_messages_.erase(pending_messages_.begin(),
+                          pending_messages_.begin() + events.size());
+
+  if (!pending_messages_.empty()) {
+    ScheduleFlush();
+  } else if (paused_for_batch_) {
+    paused_for_batch_ = false;
+    if (started_ && IsEntangled())
+      connector_->ResumeIncomingMethodCallProcessing();
+  }
+
+  gin_helper::EmitEvent(isolate, self, "messages",
+                        gin::ConvertToV8(isolate, events));
+}
+
+void MessagePort::OnConnectionError() {
+  // Messages sent before the remote end went away are still delivered, ahead
+  // of the "close" event.
+  FlushPendingMessages(true);
+  Close();
+}
+
 gin::ObjectTemplateBuilder MessagePort::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<MessagePort>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &MessagePort::PostMessage)
       .SetMethod("start", &MessagePort::Start)
-      .SetMethod("close", &MessagePort::Close);
+      .SetMethod("close", &MessagePort::Close)
+      .SetMethod("enableBatching", &MessagePort::EnableBatching);
 }
 
 const char* MessagePort::GetTypeName() {
@@ -8,11 +8,13 @@
 #include <memory>
 #include <vector>
 
+#include "base/time/time.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "third_party/blink/public/common/messaging/message_port_channel.h"
 #include "third_party/blink/public/common/messaging/message_port_descriptor.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 
 namespace gin {
 class Arguments;
@@ -32,6 +34,12 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
   void Start();
   void Close();
 
+  // Switches the port to batched delivery: messages that arrive together are
+  // handed to JS as one "messages" event carrying an array of events, at most
+  // |max_messages| at a time or as many as can be prepared within
+  // |max_duration|.
+  void EnableBatching(gin::Arguments* args);
+
   void Entangle(blink::MessagePortDescriptor port);
   void Entangle(blink::MessagePortChannel channel);
 
@@ -73,10 +81,28 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
+  v8::Local<v8::Value> CreateMessageEvent(v8::Isolate* isolate,
+                                          blink::TransferableMessage message);
+
+  // Delivers the next batch of |pending_messages_|. When |drain| is true all
+  // of them are delivered, ignoring the batch limits.
+  void FlushPendingMessages(bool drain);
+  void ScheduleFlush();
+  void OnConnectionError();
+
   std::unique_ptr<mojo::Connector> connector_;
   bool started_ = false;
   bool closed_ = false;
 
+  // Batched delivery state.
+  bool batching_ = false;
+  size_t max_batch_messages_ = 1000;
+  base::TimeDelta max_batch_duration_ = base::TimeDelta::FromMilliseconds(4);
+  std::vector<blink::TransferableMessage> pending_messages_;
+  bool flush_scheduled_ = false;
+  // Set while reading is paused because a full batch is waiting.
+  bool paused_for_batch_ = false;
+
   v8::Global<v8::Value> pinned_;
 
   // The internal port owned by this class. The handle itself is moved into the
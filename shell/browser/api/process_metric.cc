@@ -7,8 +7,17 @@
 #include <memory>
 #include <utility>
 
+#include "base/system/sys_info.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
+#if defined(OS_LINUX)
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#endif
+
 #if defined(OS_WIN)
 #include <windows.h>
 
@@ -48,8 +57,45 @@ absl::optional<mach_task_basic_info_data_t> GetTaskInfo(mach_port_t task) {
 
 #endif  // defined(OS_MAC)
 
+#if defined(OS_LINUX)
+
+namespace {
+
+// Calls |callback| with the name and the value in bytes of every
+// "Name:   1234 kB" line of a /proc file.
+template <typename Callback>
+void ForEachProcKbField(const std::string& contents, Callback callback) {
+  for (base::StringPiece line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    size_t colon = line.find(':');
+    if (colon == base::StringPiece::npos)
+      continue;
+    std::vector<base::StringPiece> value = base::SplitStringPiece(
+        line.substr(colon + 1), " \t", base::TRIM_WHITESPACE,
+        base::SPLIT_WANT_NONEMPTY);
+    size_t kb;
+    if (value.size() != 2 || value[1] != "kB" ||
+        !base::StringToSizeT(value[0], &kb))
+      continue;
+    callback(line.substr(0, colon), kb << 10);
+  }
+}
+
+}  // namespace
+
+#endif  // defined(OS_LINUX)
+
 namespace electron {
 
+ProcessMetricSample::ProcessMetricSample() = default;
+ProcessMetricSample::ProcessMetricSample(const ProcessMetricSample&) = default;
+ProcessMetricSample::~ProcessMetricSample() = default;
+
+AppMetricsSample::AppMetricsSample() = default;
+AppMetricsSample::AppMetricsSample(AppMetricsSample&&) = default;
+AppMetricsSample& AppMetricsSample::operator=(AppMetricsSample&&) = default;
+AppMetricsSample::~AppMetricsSample() = default;
+
 ProcessMetric::ProcessMetric(int type,
                              base::ProcessHandle handle,
                              std::unique_ptr<base::ProcessMetrics> metrics,
@@ -72,6 +118,41 @@ ProcessMetric::ProcessMetric(int type,
 
 ProcessMetric::~ProcessMetric() = default;
 
+ProcessMetricSample ProcessMetric::Sample(bool detailed_memory) const {
+  ProcessMetricSample sample;
+  sample.type = type;
+  sample.pid = process.Pid();
+  sample.creation_time = process.CreationTime().ToJsTime();
+  sample.service_name = service_name;
+  sample.name = name;
+  sample.percent_cpu_usage = metrics->GetPlatformIndependentCPUUsage() /
+                             base::SysInfo::NumberOfProcessors();
+  // Chrome's underlying process_metrics.cc will throw a non-fatal warning
+  // that this method isn't implemented on Windows, so it is left at 0 there.
+#if !defined(OS_WIN)
+  sample.idle_wakeups_per_second = metrics->GetIdleWakeupsPerSecond();
+#endif
+
+#if defined(OS_LINUX)
+  sample.memory = GetMemoryInfo(detailed_memory);
+  sample.open_fd_count = metrics->GetOpenFdCount();
+#else
+  sample.memory = GetMemoryInfo();
+#endif
+
+  base::IoCounters io_counters;
+  if (metrics->GetIOCounters(&io_counters))
+    sample.io_counters = io_counters;
+
+#if defined(OS_MAC)
+  sample.sandboxed = IsSandboxed();
+#elif defined(OS_WIN)
+  sample.integrity_level = GetIntegrityLevel();
+#endif
+
+  return sample;
+}
+
 #if defined(OS_WIN)
 
 ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
@@ -167,6 +248,59 @@ bool ProcessMetric::IsSandboxed() const {
 #endif
 }
 
-#endif  // defined(OS_MAC)
+#elif defined(OS_LINUX)
+
+ProcessMemoryInfo ProcessMetric::GetMemoryInfo(bool detailed_memory) const {
+  ProcessMemoryInfo result;
+  base::FilePath proc_dir =
+      base::FilePath("/proc").Append(base::NumberToString(process.Pid()));
+
+  std::string status;
+  if (base::ReadFileToString(proc_dir.Append("status"), &status)) {
+    ForEachProcKbField(status, [&](base::StringPiece name, size_t bytes) {
+      if (name == "VmRSS")
+        result.working_set_size = bytes;
+      else if (name == "VmHWM")
+        result.peak_working_set_size = bytes;
+    });
+  }
+
+  std::string smaps;
+  if (detailed_memory &&
+      base::ReadFileToString(proc_dir.Append("smaps_rollup"), &smaps)) {
+    ForEachProcKbField(smaps, [&](base::StringPiece name, size_t bytes) {
+      if (name == "Pss")
+        result.proportional_set_size = bytes;
+      else if (name == "Private_Clean" || name == "Private_Dirty")
+        result.private_bytes += bytes;
+    });
+  }
+
+  return result;
+}
+
+#endif  // defined(OS_LINUX)
+
+ProcessMetricsSampler::ProcessMetricsSampler() = default;
+
+ProcessMetricsSampler::~ProcessMetricsSampler() = default;
+
+void ProcessMetricsSampler::AddProcess(int id,
+                                       std::unique_ptr<ProcessMetric> metric) {
+  metrics_[id] = std::move(metric);
+}
+
+void ProcessMetricsSampler::RemoveProcess(int id) {
+  metrics_.erase(id);
+}
+
+AppMetricsSample ProcessMetricsSampler::Sample() {
+  AppMetricsSample sample;
+  sample.time = base::Time::Now();
+  sample.metrics.reserve(metrics_.size());
+  for (const auto& metric : metrics_)
+    sample.metrics.push_back(metric.second->Sample(true /* detailed_memory */));
+  return sample;
+}
 
 }  // namespace electron
@@ -5,24 +5,30 @@
 #ifndef SHELL_BROWSER_API_PROCESS_METRIC_H_
 #define SHELL_BROWSER_API_PROCESS_METRIC_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/macros.h"
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "base/process/process_metrics.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace electron {
 
-#if !defined(OS_LINUX)
 struct ProcessMemoryInfo {
   size_t working_set_size = 0;
   size_t peak_working_set_size = 0;
-#if defined(OS_WIN)
+#if defined(OS_WIN) || defined(OS_LINUX)
   size_t private_bytes = 0;
 #endif
-};
+#if defined(OS_LINUX)
+  size_t proportional_set_size = 0;
 #endif
+};
 
 #if defined(OS_WIN)
 enum class ProcessIntegrityLevel {
@@ -34,6 +40,41 @@ enum class ProcessIntegrityLevel {
 };
 #endif
 
+// A point in time reading of a ProcessMetric.
+struct ProcessMetricSample {
+  ProcessMetricSample();
+  ProcessMetricSample(const ProcessMetricSample&);
+  ~ProcessMetricSample();
+
+  int type = 0;
+  base::ProcessId pid = base::kNullProcessId;
+  double creation_time = 0;
+  std::string service_name;
+  std::string name;
+  double percent_cpu_usage = 0;
+  int idle_wakeups_per_second = 0;
+  ProcessMemoryInfo memory;
+  // -1 when the count is not available.
+  int open_fd_count = -1;
+  absl::optional<base::IoCounters> io_counters;
+#if defined(OS_MAC)
+  bool sandboxed = false;
+#elif defined(OS_WIN)
+  ProcessIntegrityLevel integrity_level = ProcessIntegrityLevel::kUnknown;
+#endif
+};
+
+// The samples of all processes taken at one time.
+struct AppMetricsSample {
+  AppMetricsSample();
+  AppMetricsSample(AppMetricsSample&&);
+  AppMetricsSample& operator=(AppMetricsSample&&);
+  ~AppMetricsSample();
+
+  base::Time time;
+  std::vector<ProcessMetricSample> metrics;
+};
+
 struct ProcessMetric {
   int type;
   base::Process process;
@@ -48,7 +89,14 @@ struct ProcessMetric {
                 const std::string& name = std::string());
   ~ProcessMetric();
 
-#if !defined(OS_LINUX)
+  // Reads the current usage of the process. CPU usage is measured since the
+  // previous call. On Linux |detailed_memory| also reads the proportional and
+  // private memory, which requires walking the process' page tables.
+  ProcessMetricSample Sample(bool detailed_memory) const;
+
+#if defined(OS_LINUX)
+  ProcessMemoryInfo GetMemoryInfo(bool detailed_memory) const;
+#else
   ProcessMemoryInfo GetMemoryInfo() const;
 #endif
 
@@ -60,6 +108,25 @@ struct ProcessMetric {
 #endif
 };
 
+// Samples a set of processes on a background sequence, so that polling the
+// metrics of many processes never blocks the UI thread. Owns its own
+// ProcessMetric objects since their CPU usage is tracked between samples.
+class ProcessMetricsSampler {
+ public:
+  ProcessMetricsSampler();
+  ~ProcessMetricsSampler();
+
+  void AddProcess(int id, std::unique_ptr<ProcessMetric> metric);
+  void RemoveProcess(int id);
+
+  AppMetricsSample Sample();
+
+ private:
+  std::map<int, std::unique_ptr<ProcessMetric>> metrics_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsSampler);
+};
+
 }  // namespace electron
 
 #endif  // SHELL_BROWSER_API_PROCESS_METRIC_H_
@@ -674,8 +674,8 @@ bool ElectronBrowserClient::CanCreateWindow(
   content::WebContents* web_contents =
       content::WebContents::FromRenderFrameHost(opener);
   WebContentsPreferences* prefs = WebContentsPreferences::From(web_contents);
-  if (prefs && prefs->IsEnabled(options::kNativeWindowOpen)) {
-    if (prefs->IsEnabled("disablePopups")) {
+  if (prefs && prefs->parsed().native_window_open.value_or(false)) {
+    if (prefs->parsed().disable_popups) {
       // <webview> without allowpopups attribute should return
       // null from window.open calls
       return false;
@@ -1319,6 +1319,21 @@ bool ElectronBrowserClient::WillCreateURLLoaderFactory(
   }
 #endif
 
+  auto* protocol_registry =
+      ProtocolRegistry::FromBrowserContext(browser_context);
+
+  // Proxying every request through the UI thread is only needed when there is
+  // something for ProxyingURLLoaderFactory to do, otherwise hand out the
+  // network service's factory directly.  WebRequest and ProtocolRegistry reset
+  // the partition's factories once the first listener or interceptor is added,
+  // which brings us back here to create the proxy.
+  if (!web_request->HasListener() &&
+      protocol_registry->intercept_handlers().empty() &&
+      type != URLLoaderFactoryType::kServiceWorkerScript &&
+      !base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kIgnoreConnectionsLimit))
+    return false;
+
   auto proxied_receiver = std::move(*factory_receiver);
   mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory_remote;
   *factory_receiver = target_factory_remote.InitWithNewPipeAndPassReceiver();
@@ -1339,8 +1354,6 @@ bool ElectronBrowserClient::WillCreateURLLoaderFactory(
   if (header_client)
     header_client_receiver = header_client->InitWithNewPipeAndPassReceiver();
 
-  auto* protocol_registry =
-      ProtocolRegistry::FromBrowserContext(browser_context);
   new ProxyingURLLoaderFactory(
       web_request.get(), protocol_registry->intercept_handlers(),
       render_process_id,
@@ -1369,7 +1382,7 @@ void ElectronBrowserClient::OverrideURLLoaderFactoryParams(
         blink::LocalFrameToken(factory_params->top_frame_id.value()));
     auto* web_contents = content::WebContents::FromRenderFrameHost(rfh);
     auto* prefs = WebContentsPreferences::From(web_contents);
-    if (prefs && !prefs->IsEnabled(options::kWebSecurity, true)) {
+    if (prefs && !prefs->parsed().web_security) {
       factory_params->is_corb_enabled = false;
       factory_params->disable_web_security = true;
     }
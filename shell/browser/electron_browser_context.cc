@@ -104,7 +104,7 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
                                                bool in_memory,
                                                base::DictionaryValue options)
     : storage_policy_(new SpecialStoragePolicy),
-      protocol_registry_(new ProtocolRegistry),
+      protocol_registry_(new ProtocolRegistry(this)),
       in_memory_(in_memory),
       ssl_config_(network::mojom::SSLConfig::New()) {
   user_agent_ = ElectronBrowserClient::Get()->GetUserAgent();
@@ -404,6 +404,13 @@ network::mojom::SSLConfigPtr ElectronBrowserContext::GetSSLConfig() {
   return ssl_config_.Clone();
 }
 
+void ElectronBrowserContext::ResetURLLoaderFactories() {
+  ForEachStoragePartition(
+      base::BindRepeating([](content::StoragePartition* storage_partition) {
+        storage_partition->ResetURLLoaderFactories();
+      }));
+}
+
 void ElectronBrowserContext::SetSSLConfig(network::mojom::SSLConfigPtr config) {
   ssl_config_ = std::move(config);
   if (ssl_config_client_) {
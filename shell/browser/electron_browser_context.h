@@ -137,6 +137,10 @@ class ElectronBrowserContext : public content::BrowserContext {
     return protocol_registry_.get();
   }
 
+  // Drops the URLLoaderFactories handed out by our storage partitions so that
+  // they get re-created, e.g. with a ProxyingURLLoaderFactory in place.
+  void ResetURLLoaderFactories();
+
   void SetSSLConfig(network::mojom::SSLConfigPtr config);
   network::mojom::SSLConfigPtr GetSSLConfig();
   void SetSSLConfigClient(mojo::Remote<network::mojom::SSLConfigClient> client);
@@ -27,7 +27,6 @@
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
-#include "shell/common/options_switches.h"
 
 namespace electron {
 
@@ -127,7 +126,7 @@ void ElectronDownloadManagerDelegate::OnDownloadPathGenerated(
 
     auto* web_preferences = WebContentsPreferences::From(web_contents);
     const bool offscreen =
-        !web_preferences || web_preferences->IsEnabled(options::kOffscreen);
+        !web_preferences || web_preferences->parsed().offscreen;
     settings.force_detached = offscreen;
 
     v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
@@ -61,7 +61,7 @@ void ElectronJavaScriptDialogManager::RunJavaScriptDialog(
 
   auto* web_preferences = WebContentsPreferences::From(web_contents);
 
-  if (web_preferences && web_preferences->IsEnabled("disableDialogs")) {
+  if (web_preferences && web_preferences->parsed().disable_dialogs) {
     return std::move(callback).Run(false, std::u16string());
   }
 
@@ -88,7 +88,7 @@ void ElectronJavaScriptDialogManager::RunJavaScriptDialog(
 
   // Don't set parent for offscreen window.
   NativeWindow* window = nullptr;
-  if (web_preferences && !web_preferences->IsEnabled(options::kOffscreen)) {
+  if (web_preferences && !web_preferences->parsed().offscreen) {
     auto* relay = NativeWindowRelay::FromWebContents(web_contents);
     if (relay)
       window = relay->GetNativeWindow();
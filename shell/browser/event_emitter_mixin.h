@@ -30,9 +30,13 @@ class EventEmitterMixin {
     v8::Local<v8::Object> wrapper;
     if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
       return false;
+    v8::Local<v8::String> event_name = gin::StringToSymbol(isolate, name);
+    if (!internal::HasListeners(isolate, wrapper, event_name))
+      return false;
     v8::Local<v8::Object> event = internal::CreateEvent(isolate, wrapper);
-    return EmitWithEvent(isolate, wrapper, name, event,
-                         std::forward<Args>(args)...);
+    gin_helper::EmitEvent(isolate, wrapper, event_name, event,
+                          std::forward<Args>(args)...);
+    return internal::IsDefaultPrevented(isolate, event);
   }
 
   // this.emit(name, event, args...);
@@ -45,8 +49,12 @@ class EventEmitterMixin {
     v8::Local<v8::Object> wrapper;
     if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
       return false;
-    return EmitWithEvent(isolate, wrapper, name, custom_event,
-                         std::forward<Args>(args)...);
+    v8::Local<v8::String> event_name = gin::StringToSymbol(isolate, name);
+    if (!internal::HasListeners(isolate, wrapper, event_name))
+      return false;
+    gin_helper::EmitEvent(isolate, wrapper, event_name, custom_event,
+                          std::forward<Args>(args)...);
+    return internal::GetDefaultPrevented(isolate, custom_event);
   }
 
  protected:
@@ -70,24 +78,6 @@ class EventEmitterMixin {
   }
 
  private:
-  // this.emit(name, event, args...);
-  template <typename... Args>
-  static bool EmitWithEvent(v8::Isolate* isolate,
-                            v8::Local<v8::Object> wrapper,
-                            base::StringPiece name,
-                            v8::Local<v8::Object> event,
-                            Args&&... args) {
-    auto context = isolate->GetCurrentContext();
-    gin_helper::EmitEvent(isolate, wrapper, name, event,
-                          std::forward<Args>(args)...);
-    v8::Local<v8::Value> defaultPrevented;
-    if (event->Get(context, gin::StringToV8(isolate, "defaultPrevented"))
-            .ToLocal(&defaultPrevented)) {
-      return defaultPrevented->BooleanValue(isolate);
-    }
-    return false;
-  }
-
   DISALLOW_COPY_AND_ASSIGN(EventEmitterMixin);
 };
 
@@ -22,6 +22,7 @@
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/pref_names.h"
 #include "extensions/common/file_util.h"
+#include "shell/browser/extensions/electron_message_bundle_cache.h"
 
 namespace extensions {
 
@@ -68,8 +69,10 @@ std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
 }  // namespace
 
 ElectronExtensionLoader::ElectronExtensionLoader(
-    content::BrowserContext* browser_context)
+    content::BrowserContext* browser_context,
+    ElectronMessageBundleCache* message_bundle_cache)
     : browser_context_(browser_context),
+      message_bundle_cache_(message_bundle_cache),
       extension_registrar_(browser_context, this) {}
 
 ElectronExtensionLoader::~ElectronExtensionLoader() = default;
@@ -91,6 +94,8 @@ void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
   // We shouldn't be trying to reload extensions that haven't been added.
   DCHECK(extension);
 
+  message_bundle_cache_->Invalidate(extension_id);
+
   // This should always start false since it's only set here, or in
   // LoadExtensionForReload() as a result of the call below.
   DCHECK_EQ(false, did_schedule_reload_);
@@ -104,6 +109,7 @@ void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
 void ElectronExtensionLoader::UnloadExtension(
     const ExtensionId& extension_id,
     extensions::UnloadedExtensionReason reason) {
+  message_bundle_cache_->Invalidate(extension_id);
   extension_registrar_.RemoveExtension(extension_id, reason);
 }
 
@@ -129,6 +135,9 @@ void ElectronExtensionLoader::FinishExtensionLoad(
       preference->SetString(
           "install_time", base::NumberToString(install_time.ToInternalValue()));
     }
+
+    // Renderers ask for the message bundle as soon as the extension runs.
+    message_bundle_cache_->Preload(extension.get());
   }
 
   std::move(cb).Run(extension.get(), result.second);
@@ -140,6 +149,7 @@ void ElectronExtensionLoader::FinishExtensionReload(
   scoped_refptr<const Extension> extension = result.first;
   if (extension) {
     extension_registrar_.AddExtension(extension);
+    message_bundle_cache_->Preload(extension.get());
   }
 }
 
@@ -25,12 +25,14 @@ class BrowserContext;
 
 namespace extensions {
 
+class ElectronMessageBundleCache;
 class Extension;
 
 // Handles extension loading and reloading using ExtensionRegistrar.
 class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
  public:
-  explicit ElectronExtensionLoader(content::BrowserContext* browser_context);
+  ElectronExtensionLoader(content::BrowserContext* browser_context,
+                          ElectronMessageBundleCache* message_bundle_cache);
   ~ElectronExtensionLoader() override;
 
   // Loads an unpacked extension from a directory synchronously. Returns the
@@ -79,6 +81,9 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
 
   content::BrowserContext* browser_context_;  // Not owned.
 
+  // Owned by ElectronExtensionSystem, which outlives us.
+  ElectronMessageBundleCache* message_bundle_cache_;
+
   // Registers and unregisters extensions.
   ExtensionRegistrar extension_registrar_;
 
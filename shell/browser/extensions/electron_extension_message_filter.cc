@@ -12,10 +12,10 @@
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
-#include "base/task/thread_pool.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/render_process_host.h"
@@ -23,10 +23,8 @@
 #include "extensions/browser/extension_system.h"
 #include "extensions/common/extension_messages.h"
 #include "extensions/common/extension_set.h"
-#include "extensions/common/file_util.h"
-#include "extensions/common/manifest_handlers/default_locale_handler.h"
-#include "extensions/common/manifest_handlers/shared_module_info.h"
 #include "extensions/common/message_bundle.h"
+#include "shell/browser/extensions/electron_extension_system.h"
 
 using content::BrowserThread;
 
@@ -92,66 +90,31 @@ void ElectronExtensionMessageFilter::OnGetExtMessageBundle(
           ->enabled_extensions();
   const extensions::Extension* extension = extension_set.GetByID(extension_id);
 
-  if (!extension) {  // The extension has gone.
+  auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
+      extensions::ExtensionSystem::Get(browser_context_));
+  // The cache is gone once the extension system has been shut down.
+  auto* message_bundle_cache = extension_system->message_bundle_cache();
+
+  if (!extension || !message_bundle_cache) {  // The extension has gone.
     ExtensionHostMsg_GetMessageBundle::WriteReplyParams(
         reply_msg, extensions::MessageBundle::SubstitutionMap());
     Send(reply_msg);
     return;
   }
 
-  const std::string& default_locale =
-      extensions::LocaleInfo::GetDefaultLocale(extension);
-  if (default_locale.empty()) {
-    // A little optimization: send the answer here to avoid an extra thread hop.
-    std::unique_ptr<extensions::MessageBundle::SubstitutionMap> dictionary_map(
-        extensions::file_util::LoadNonLocalizedMessageBundleSubstitutionMap(
-            extension_id));
-    ExtensionHostMsg_GetMessageBundle::WriteReplyParams(reply_msg,
-                                                        *dictionary_map);
-    Send(reply_msg);
-    return;
-  }
-
-  std::vector<base::FilePath> paths_to_load;
-  paths_to_load.push_back(extension->path());
-
-  auto imports = extensions::SharedModuleInfo::GetImports(extension);
-  // Iterate through the imports in reverse.  This will allow later imported
-  // modules to override earlier imported modules, as the list order is
-  // maintained from the definition in manifest.json of the imports.
-  for (auto it = imports.rbegin(); it != imports.rend(); ++it) {
-    const extensions::Extension* imported_extension =
-        extension_set.GetByID(it->extension_id);
-    if (!imported_extension) {
-      NOTREACHED() << "Missing shared module " << it->extension_id;
-      continue;
-    }
-    paths_to_load.push_back(imported_extension->path());
-  }
-
-  // This blocks tab loading. Priority is inherited from the calling context.
-  base::ThreadPool::PostTask(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(
-          &ElectronExtensionMessageFilter::OnGetExtMessageBundleAsync, this,
-          paths_to_load, extension_id, default_locale,
-          extension_l10n_util::GetGzippedMessagesPermissionForExtension(
-              extension),
-          reply_msg));
+  message_bundle_cache->GetBundle(
+      extension,
+      base::BindOnce(&ElectronExtensionMessageFilter::OnMessageBundleReady,
+                     this, reply_msg));
 }
 
-void ElectronExtensionMessageFilter::OnGetExtMessageBundleAsync(
-    const std::vector<base::FilePath>& extension_paths,
-    const std::string& main_extension_id,
-    const std::string& default_locale,
-    extension_l10n_util::GzippedMessagesPermission gzip_permission,
-    IPC::Message* reply_msg) {
-  std::unique_ptr<extensions::MessageBundle::SubstitutionMap> dictionary_map(
-      extensions::file_util::LoadMessageBundleSubstitutionMapFromPaths(
-          extension_paths, main_extension_id, default_locale, gzip_permission));
-
-  ExtensionHostMsg_GetMessageBundle::WriteReplyParams(reply_msg,
-                                                      *dictionary_map);
+void ElectronExtensionMessageFilter::OnMessageBundleReady(
+    IPC::Message* reply_msg,
+    scoped_refptr<extensions::ElectronMessageBundleCache::SerializedBundle>
+        bundle) {
+  // The bundle holds the reply parameters already pickled.
+  reply_msg->WriteBytes(bundle->data.payload(),
+                        base::checked_cast<int>(bundle->data.payload_size()));
   Send(reply_msg);
 }
 
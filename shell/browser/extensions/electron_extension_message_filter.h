@@ -13,7 +13,7 @@
 #include "base/sequenced_task_runner_helpers.h"
 #include "content/public/browser/browser_message_filter.h"
 #include "content/public/browser/browser_thread.h"
-#include "extensions/common/extension_l10n_util.h"
+#include "shell/browser/extensions/electron_message_bundle_cache.h"
 
 namespace content {
 class BrowserContext;
@@ -46,12 +46,10 @@ class ElectronExtensionMessageFilter : public content::BrowserMessageFilter {
 
   void OnGetExtMessageBundle(const std::string& extension_id,
                              IPC::Message* reply_msg);
-  void OnGetExtMessageBundleAsync(
-      const std::vector<base::FilePath>& extension_paths,
-      const std::string& main_extension_id,
-      const std::string& default_locale,
-      extension_l10n_util::GzippedMessagesPermission gzip_permission,
-      IPC::Message* reply_msg);
+  void OnMessageBundleReady(
+      IPC::Message* reply_msg,
+      scoped_refptr<extensions::ElectronMessageBundleCache::SerializedBundle>
+          bundle);
 
   const int render_process_id_;
 
@@ -36,6 +36,7 @@
 #include "extensions/common/constants.h"
 #include "extensions/common/file_util.h"
 #include "shell/browser/extensions/electron_extension_loader.h"
+#include "shell/browser/extensions/electron_message_bundle_cache.h"
 
 #if BUILDFLAG(ENABLE_PDF_VIEWER)
 #include "chrome/browser/pdf/pdf_extension_util.h"  // nogncheck
@@ -76,6 +77,7 @@ void ElectronExtensionSystem::RemoveExtension(const ExtensionId& extension_id) {
 
 void ElectronExtensionSystem::Shutdown() {
   extension_loader_.reset();
+  message_bundle_cache_.reset();
 }
 
 void ElectronExtensionSystem::InitForRegularProfile(bool extensions_enabled) {
@@ -86,8 +88,10 @@ void ElectronExtensionSystem::InitForRegularProfile(bool extensions_enabled) {
   quota_service_ = std::make_unique<QuotaService>();
   user_script_manager_ = std::make_unique<UserScriptManager>(browser_context_);
   app_sorting_ = std::make_unique<NullAppSorting>();
-  extension_loader_ =
-      std::make_unique<ElectronExtensionLoader>(browser_context_);
+  message_bundle_cache_ =
+      std::make_unique<ElectronMessageBundleCache>(browser_context_);
+  extension_loader_ = std::make_unique<ElectronExtensionLoader>(
+      browser_context_, message_bundle_cache_.get());
 
   if (!browser_context_->IsOffTheRecord())
     LoadComponentExtensions();
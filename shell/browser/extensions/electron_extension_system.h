@@ -26,6 +26,7 @@ class BrowserContext;
 namespace extensions {
 
 class ElectronExtensionLoader;
+class ElectronMessageBundleCache;
 class ValueStoreFactory;
 
 // A simplified version of ExtensionSystem for app_shell. Allows
@@ -51,6 +52,10 @@ class ElectronExtensionSystem : public ExtensionSystem {
 
   void RemoveExtension(const ExtensionId& extension_id);
 
+  ElectronMessageBundleCache* message_bundle_cache() {
+    return message_bundle_cache_.get();
+  }
+
   // KeyedService implementation:
   void Shutdown() override;
 
@@ -106,6 +111,7 @@ class ElectronExtensionSystem : public ExtensionSystem {
   std::unique_ptr<AppSorting> app_sorting_;
   std::unique_ptr<ManagementPolicy> management_policy_;
 
+  std::unique_ptr<ElectronMessageBundleCache> message_bundle_cache_;
   std::unique_ptr<ElectronExtensionLoader> extension_loader_;
 
   scoped_refptr<ValueStoreFactory> store_factory_;
@@ -0,0 +1,186 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/extensions/electron_message_bundle_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/stl_util.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/browser_thread.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/common/extension.h"
+#include "extensions/common/extension_l10n_util.h"
+#include "extensions/common/extension_set.h"
+#include "extensions/common/file_util.h"
+#include "extensions/common/manifest_handlers/default_locale_handler.h"
+#include "extensions/common/manifest_handlers/shared_module_info.h"
+#include "extensions/common/message_bundle.h"
+#include "ipc/ipc_message_utils.h"
+
+using content::BrowserThread;
+
+namespace extensions {
+
+namespace {
+
+scoped_refptr<ElectronMessageBundleCache::SerializedBundle> SerializeBundle(
+    const MessageBundle::SubstitutionMap& dictionary_map) {
+  auto bundle =
+      base::MakeRefCounted<ElectronMessageBundleCache::SerializedBundle>();
+  IPC::WriteParam(&bundle->data, dictionary_map);
+  return bundle;
+}
+
+scoped_refptr<ElectronMessageBundleCache::SerializedBundle> LoadBundle(
+    const std::vector<base::FilePath>& extension_paths,
+    const std::string& main_extension_id,
+    const std::string& default_locale,
+    extension_l10n_util::GzippedMessagesPermission gzip_permission) {
+  std::unique_ptr<MessageBundle::SubstitutionMap> dictionary_map(
+      file_util::LoadMessageBundleSubstitutionMapFromPaths(
+          extension_paths, main_extension_id, default_locale,
+          gzip_permission));
+  return SerializeBundle(*dictionary_map);
+}
+
+}  // namespace
+
+ElectronMessageBundleCache::Entry::Entry() = default;
+ElectronMessageBundleCache::Entry::~Entry() = default;
+ElectronMessageBundleCache::Entry::Entry(Entry&&) = default;
+ElectronMessageBundleCache::Entry& ElectronMessageBundleCache::Entry::operator=(
+    Entry&&) = default;
+
+ElectronMessageBundleCache::ElectronMessageBundleCache(
+    content::BrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+ElectronMessageBundleCache::~ElectronMessageBundleCache() {
+  // Requests still waiting for a bundle get an empty one.
+  for (auto& it : entries_) {
+    for (auto& callback : it.second.pending)
+      std::move(callback).Run(SerializeBundle({}));
+  }
+}
+
+void ElectronMessageBundleCache::GetBundle(const Extension* extension,
+                                           BundleCallback callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  Entry* entry = GetOrLoadEntry(extension);
+  if (!entry) {
+    // A little optimization: build the answer here to avoid an extra thread
+    // hop, only the predefined messages are needed.
+    std::unique_ptr<MessageBundle::SubstitutionMap> dictionary_map(
+        file_util::LoadNonLocalizedMessageBundleSubstitutionMap(
+            extension->id()));
+    std::move(callback).Run(SerializeBundle(*dictionary_map));
+    return;
+  }
+
+  if (entry->bundle)
+    std::move(callback).Run(entry->bundle);
+  else
+    entry->pending.push_back(std::move(callback));
+}
+
+void ElectronMessageBundleCache::Preload(const Extension* extension) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  GetOrLoadEntry(extension);
+}
+
+void ElectronMessageBundleCache::Invalidate(const ExtensionId& extension_id) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  base::EraseIf(entries_, [&extension_id](auto& it) {
+    Entry& entry = it.second;
+    if (!base::Contains(entry.sources, extension_id))
+      return false;
+    // Entries that are still loading answer their pending requests first.
+    if (!entry.bundle) {
+      entry.stale = true;
+      return false;
+    }
+    return true;
+  });
+}
+
+ElectronMessageBundleCache::Entry* ElectronMessageBundleCache::GetOrLoadEntry(
+    const Extension* extension) {
+  const std::string& default_locale = LocaleInfo::GetDefaultLocale(extension);
+  if (default_locale.empty())
+    return nullptr;
+
+  std::string key =
+      extension->id() + ":" + extension_l10n_util::CurrentLocaleOrDefault();
+  auto it = entries_.find(key);
+  if (it != entries_.end() && !it->second.stale)
+    return &it->second;
+
+  const ExtensionSet& extension_set =
+      ExtensionRegistry::Get(browser_context_)->enabled_extensions();
+
+  Entry entry;
+  std::vector<base::FilePath> paths_to_load;
+  paths_to_load.push_back(extension->path());
+  entry.sources.push_back(extension->id());
+
+  auto imports = SharedModuleInfo::GetImports(extension);
+  // Iterate through the imports in reverse.  This will allow later imported
+  // modules to override earlier imported modules, as the list order is
+  // maintained from the definition in manifest.json of the imports.
+  for (auto import = imports.rbegin(); import != imports.rend(); ++import) {
+    const Extension* imported_extension =
+        extension_set.GetByID(import->extension_id);
+    if (!imported_extension) {
+      NOTREACHED() << "Missing shared module " << import->extension_id;
+      continue;
+    }
+    paths_to_load.push_back(imported_extension->path());
+    entry.sources.push_back(imported_extension->id());
+  }
+
+  // Requests waiting on a stale entry are answered by the new load, the
+  // result of the old one is dropped.
+  if (it != entries_.end())
+    entry.pending = std::move(it->second.pending);
+  entry.load_id = ++next_load_id_;
+
+  // This blocks tab loading. Priority is inherited from the calling context.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(
+          &LoadBundle, std::move(paths_to_load), extension->id(),
+          default_locale,
+          extension_l10n_util::GetGzippedMessagesPermissionForExtension(
+              extension)),
+      base::BindOnce(&ElectronMessageBundleCache::OnBundleLoaded,
+                     weak_factory_.GetWeakPtr(), key, entry.load_id));
+
+  return &(entries_[key] = std::move(entry));
+}
+
+void ElectronMessageBundleCache::OnBundleLoaded(
+    const std::string& key,
+    uint64_t load_id,
+    scoped_refptr<SerializedBundle> bundle) {
+  auto it = entries_.find(key);
+  if (it == entries_.end() || it->second.load_id != load_id)
+    return;
+
+  Entry& entry = it->second;
+  std::vector<BundleCallback> pending = std::move(entry.pending);
+  if (entry.stale)
+    entries_.erase(it);
+  else
+    entry.bundle = bundle;
+
+  for (auto& callback : pending)
+    std::move(callback).Run(bundle);
+}
+
+}  // namespace extensions
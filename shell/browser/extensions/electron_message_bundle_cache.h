@@ -0,0 +1,92 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_EXTENSIONS_ELECTRON_MESSAGE_BUNDLE_CACHE_H_
+#define SHELL_BROWSER_EXTENSIONS_ELECTRON_MESSAGE_BUNDLE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/pickle.h"
+#include "extensions/common/extension_id.h"
+
+namespace content {
+class BrowserContext;
+}
+
+namespace extensions {
+
+class Extension;
+
+// Keeps the i18n message bundles of loaded extensions, so that the
+// messages.json files of an extension are read and parsed once per locale
+// instead of once for every renderer that asks for them.
+class ElectronMessageBundleCache {
+ public:
+  // The substitution map of a bundle, pickled the same way as the reply
+  // parameters of ExtensionHostMsg_GetMessageBundle so it can be appended to
+  // every reply without being serialized again.
+  using SerializedBundle = base::RefCountedData<base::Pickle>;
+  using BundleCallback =
+      base::OnceCallback<void(scoped_refptr<SerializedBundle>)>;
+
+  explicit ElectronMessageBundleCache(content::BrowserContext* browser_context);
+  ~ElectronMessageBundleCache();
+
+  // Runs |callback| with the bundle of |extension| in the current locale,
+  // loading it on the thread pool if it is not cached yet.
+  void GetBundle(const Extension* extension, BundleCallback callback);
+
+  // Starts loading the bundle of |extension| ahead of the first request.
+  void Preload(const Extension* extension);
+
+  // Drops the bundles that were built from the files of |extension_id|,
+  // including the bundles of extensions importing it as a shared module.
+  void Invalidate(const ExtensionId& extension_id);
+
+ private:
+  struct Entry {
+    Entry();
+    ~Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+
+    // Null while the bundle is being loaded.
+    scoped_refptr<SerializedBundle> bundle;
+    // The extensions whose files the bundle was built from.
+    std::vector<ExtensionId> sources;
+    // Requests waiting for the bundle to be loaded.
+    std::vector<BundleCallback> pending;
+    // Identifies the load that will fill in |bundle|.
+    uint64_t load_id = 0;
+    // Set when the entry got invalidated while loading.
+    bool stale = false;
+  };
+
+  // Returns the entry of |extension|, starting to load it when it is missing.
+  // Returns null for extensions without localized messages.
+  Entry* GetOrLoadEntry(const Extension* extension);
+  void OnBundleLoaded(const std::string& key,
+                      uint64_t load_id,
+                      scoped_refptr<SerializedBundle> bundle);
+
+  content::BrowserContext* browser_context_;  // Not owned.
+
+  // Keyed by extension id and locale.
+  std::map<std::string, Entry> entries_;
+  uint64_t next_load_id_ = 0;
+
+  base::WeakPtrFactory<ElectronMessageBundleCache> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ElectronMessageBundleCache);
+};
+
+}  // namespace extensions
+
+#endif  // SHELL_BROWSER_EXTENSIONS_ELECTRON_MESSAGE_BUNDLE_CACHE_H_
@@ -18,6 +18,7 @@
 #include "net/base/filename_util.h"
 #include "net/http/http_status_code.h"
 #include "net/url_request/redirect_util.h"
+#include "services/network/public/cpp/resource_request_body.h"
 #include "services/network/public/cpp/url_loader_completion_status.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/electron_api_session.h"
@@ -314,9 +315,13 @@ void ElectronURLLoaderFactory::StartLoading(
           std::move(loader), request_id, options, new_request,
           std::move(client), traffic_annotation);
     } else {
+      // Handlers have to name the URL they load, here it is the redirect
+      // target.
+      gin_helper::Dictionary redirect_dict =
+          gin::Dictionary::CreateEmpty(args->isolate());
+      redirect_dict.Set("url", new_request.url);
       StartLoadingHttp(std::move(loader), new_request, std::move(client),
-                       traffic_annotation,
-                       gin::Dictionary::CreateEmpty(args->isolate()));
+                       traffic_annotation, redirect_dict);
     }
     return;
   }
@@ -452,9 +457,33 @@ void ElectronURLLoaderFactory::StartLoadingHttp(
   if (!dict.Get("method", &request->method))
     request->method = original_request.method;
 
-  base::DictionaryValue upload_data;
-  if (request->method != "GET" && request->method != "HEAD")
-    dict.Get("uploadData", &upload_data);
+  if (request->method != "GET" && request->method != "HEAD") {
+    gin_helper::Dictionary upload_data;
+    if (dict.Get("uploadData", &upload_data)) {
+      std::string content_type;
+      v8::Local<v8::Value> data;
+      if (upload_data.Get("contentType", &content_type) &&
+          upload_data.Get("data", &data)) {
+        if (node::Buffer::HasInstance(data)) {
+          request->request_body = network::ResourceRequestBody::CreateFromBytes(
+              node::Buffer::Data(data), node::Buffer::Length(data));
+        } else {
+          std::string body;
+          gin::ConvertFromV8(dict.isolate(), data, &body);
+          request->request_body = network::ResourceRequestBody::CreateFromBytes(
+              body.data(), body.size());
+        }
+        request->headers.SetHeader(net::HttpRequestHeaders::kContentType,
+                                   content_type);
+      }
+    } else if (request->method == original_request.method) {
+      // Forward the body of the original request, it can be made of bytes,
+      // files, blobs or data pipes that are all consumed by the network
+      // service directly.
+      request->request_body = original_request.request_body;
+      request->enable_upload_progress = original_request.enable_upload_progress;
+    }
+  }
 
   ElectronBrowserContext* browser_context =
       ElectronBrowserContext::From("", false);
@@ -472,11 +501,8 @@ void ElectronURLLoaderFactory::StartLoadingHttp(
     }
   }
 
-  new URLPipeLoader(
-      browser_context->GetURLLoaderFactory(), std::move(request),
-      std::move(loader), std::move(client),
-      static_cast<net::NetworkTrafficAnnotationTag>(traffic_annotation),
-      std::move(upload_data));
+  new URLPipeLoader(browser_context->GetURLLoaderFactory(), std::move(request),
+                    std::move(loader), std::move(client), traffic_annotation);
 }
 
 // static
@@ -0,0 +1,106 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/url_pattern_matcher.h"
+
+#include <utility>
+
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "url/url_constants.h"
+
+namespace electron {
+
+namespace {
+
+// URLPattern ignores case and a trailing dot when comparing hosts, make the
+// index keys agree with it.
+std::string NormalizeHost(base::StringPiece host) {
+  if (base::EndsWith(host, "."))
+    host.remove_suffix(1);
+  return base::ToLowerASCII(host);
+}
+
+// Whether |pattern| can match URLs of any host, URLPattern does not look at
+// the host of file: URLs at all.
+bool IsHostAgnostic(const URLPattern& pattern) {
+  return pattern.match_all_urls() || pattern.scheme() == url::kFileScheme ||
+         (pattern.match_subdomains() && pattern.host().empty());
+}
+
+}  // namespace
+
+URLPatternMatcher::URLPatternMatcher() = default;
+
+URLPatternMatcher::URLPatternMatcher(const std::set<URLPattern>& patterns)
+    : patterns_(patterns.begin(), patterns.end()) {
+  for (size_t i = 0; i < patterns_.size(); ++i) {
+    const URLPattern& pattern = patterns_[i];
+    if (IsHostAgnostic(pattern)) {
+      any_host_.push_back(i);
+    } else if (pattern.match_subdomains()) {
+      subdomain_hosts_[NormalizeHost(pattern.host())].push_back(i);
+    } else {
+      exact_hosts_[NormalizeHost(pattern.host())].push_back(i);
+    }
+  }
+}
+
+URLPatternMatcher::~URLPatternMatcher() = default;
+
+URLPatternMatcher::URLPatternMatcher(URLPatternMatcher&&) = default;
+URLPatternMatcher& URLPatternMatcher::operator=(URLPatternMatcher&&) = default;
+
+bool URLPatternMatcher::MatchesURL(const GURL& url) const {
+  // filesystem: URLs are matched by URLPattern against their inner URL, which
+  // the host index knows nothing about.
+  if (url.SchemeIsFileSystem()) {
+    for (const auto& pattern : patterns_) {
+      if (pattern.MatchesURL(url))
+        return true;
+    }
+    return false;
+  }
+
+  if (MatchesAny(&any_host_, url))
+    return true;
+
+  const std::string host = NormalizeHost(url.host_piece());
+  if (MatchesAnyInMap(exact_hosts_, host, url))
+    return true;
+
+  if (subdomain_hosts_.empty())
+    return false;
+
+  // Walk "a.b.example.com", "b.example.com", "example.com" and "com".
+  base::StringPiece suffix(host);
+  while (!suffix.empty()) {
+    if (MatchesAnyInMap(subdomain_hosts_, std::string(suffix), url))
+      return true;
+    size_t dot = suffix.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    suffix.remove_prefix(dot + 1);
+  }
+  return false;
+}
+
+bool URLPatternMatcher::MatchesAny(const PatternIndices* indices,
+                                   const GURL& url) const {
+  for (size_t index : *indices) {
+    if (patterns_[index].MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
+bool URLPatternMatcher::MatchesAnyInMap(
+    const std::unordered_map<std::string, PatternIndices>& map,
+    const std::string& host,
+    const GURL& url) const {
+  auto it = map.find(host);
+  return it != map.end() && MatchesAny(&it->second, url);
+}
+
+}  // namespace electron
@@ -0,0 +1,62 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
+#define SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Matches URLs against a fixed set of URLPatterns.
+//
+// The patterns are indexed by host when the matcher is built, so matching a
+// URL only has to run URLPattern::MatchesURL against the patterns that could
+// possibly apply to its host instead of scanning every pattern.  This keeps
+// webRequest filters with thousands of patterns cheap to evaluate.
+class URLPatternMatcher {
+ public:
+  URLPatternMatcher();
+  explicit URLPatternMatcher(const std::set<URLPattern>& patterns);
+  ~URLPatternMatcher();
+
+  URLPatternMatcher(URLPatternMatcher&&);
+  URLPatternMatcher& operator=(URLPatternMatcher&&);
+
+  bool empty() const { return patterns_.empty(); }
+  size_t size() const { return patterns_.size(); }
+
+  // Returns true if any of the patterns matches |url|.
+  bool MatchesURL(const GURL& url) const;
+
+ private:
+  using PatternIndices = std::vector<size_t>;
+
+  bool MatchesAny(const PatternIndices* indices, const GURL& url) const;
+  bool MatchesAnyInMap(
+      const std::unordered_map<std::string, PatternIndices>& map,
+      const std::string& host,
+      const GURL& url) const;
+
+  std::vector<URLPattern> patterns_;
+  // Patterns for one exact host, keyed by that host.
+  std::unordered_map<std::string, PatternIndices> exact_hosts_;
+  // "*.host" patterns keyed by |host|, they also match |host| itself.
+  std::unordered_map<std::string, PatternIndices> subdomain_hosts_;
+  // Patterns that can match any host and have to be tested against every URL.
+  PatternIndices any_host_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLPatternMatcher);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
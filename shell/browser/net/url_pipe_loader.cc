@@ -7,8 +7,9 @@
 #include <utility>
 
 #include "mojo/public/cpp/bindings/pending_remote.h"
-#include "mojo/public/cpp/system/string_data_source.h"
+#include "net/base/net_errors.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
 
 namespace electron {
 
@@ -17,8 +18,7 @@ URLPipeLoader::URLPipeLoader(
     std::unique_ptr<network::ResourceRequest> request,
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
-    const net::NetworkTrafficAnnotationTag& annotation,
-    base::DictionaryValue upload_data)
+    const net::MutableNetworkTrafficAnnotationTag& annotation)
     : url_loader_(this, std::move(loader)), client_(std::move(client)) {
   url_loader_.set_disconnect_handler(base::BindOnce(
       &URLPipeLoader::NotifyComplete, base::Unretained(this), net::ERR_FAILED));
@@ -27,7 +27,7 @@ URLPipeLoader::URLPipeLoader(
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
       base::BindOnce(&URLPipeLoader::Start, weak_factory_.GetWeakPtr(), factory,
-                     std::move(request), annotation, std::move(upload_data)));
+                     std::move(request), annotation));
 }
 
 URLPipeLoader::~URLPipeLoader() = default;
@@ -35,20 +35,13 @@ URLPipeLoader::~URLPipeLoader() = default;
 void URLPipeLoader::Start(
     scoped_refptr<network::SharedURLLoaderFactory> factory,
     std::unique_ptr<network::ResourceRequest> request,
-    const net::NetworkTrafficAnnotationTag& annotation,
-    base::DictionaryValue upload_data) {
-  loader_ = network::SimpleURLLoader::Create(std::move(request), annotation);
-  loader_->SetOnResponseStartedCallback(base::BindOnce(
-      &URLPipeLoader::OnResponseStarted, weak_factory_.GetWeakPtr()));
-
-  // TODO(zcbenz): The old protocol API only supports string as upload data,
-  // we should seek to support more types in future.
-  std::string content_type, data;
-  if (upload_data.GetString("contentType", &content_type) &&
-      upload_data.GetString("data", &data))
-    loader_->AttachStringForUpload(data, content_type);
-
-  loader_->DownloadAsStream(factory.get(), this);
+    const net::MutableNetworkTrafficAnnotationTag& annotation) {
+  factory->CreateLoaderAndStart(
+      upstream_loader_.BindNewPipeAndPassReceiver(), 0,
+      network::mojom::kURLLoadOptionNone, *request,
+      upstream_client_.BindNewPipeAndPassRemote(), annotation);
+  upstream_client_.set_disconnect_handler(base::BindOnce(
+      &URLPipeLoader::NotifyComplete, base::Unretained(this), net::ERR_FAILED));
 }
 
 void URLPipeLoader::NotifyComplete(int result) {
@@ -56,46 +49,61 @@ void URLPipeLoader::NotifyComplete(int result) {
   delete this;
 }
 
-void URLPipeLoader::OnResponseStarted(
-    const GURL& final_url,
-    const network::mojom::URLResponseHead& response_head) {
-  mojo::ScopedDataPipeProducerHandle producer;
-  mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
-  if (rv != MOJO_RESULT_OK) {
-    NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
-    return;
-  }
-
-  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
-
-  client_->OnReceiveResponse(response_head.Clone());
-  client_->OnStartLoadingResponseBody(std::move(consumer));
+void URLPipeLoader::SetPriority(net::RequestPriority priority,
+                                int32_t intra_priority_value) {
+  if (upstream_loader_.is_bound())
+    upstream_loader_->SetPriority(priority, intra_priority_value);
+}
+
+void URLPipeLoader::PauseReadingBodyFromNet() {
+  if (upstream_loader_.is_bound())
+    upstream_loader_->PauseReadingBodyFromNet();
+}
+
+void URLPipeLoader::ResumeReadingBodyFromNet() {
+  if (upstream_loader_.is_bound())
+    upstream_loader_->ResumeReadingBodyFromNet();
+}
+
+void URLPipeLoader::OnReceiveEarlyHints(
+    network::mojom::EarlyHintsPtr early_hints) {
+  client_->OnReceiveEarlyHints(std::move(early_hints));
 }
 
-void URLPipeLoader::OnWrite(base::OnceClosure resume, MojoResult result) {
-  if (result == MOJO_RESULT_OK)
-    std::move(resume).Run();
-  else
-    NotifyComplete(net::ERR_FAILED);
+void URLPipeLoader::OnReceiveResponse(network::mojom::URLResponseHeadPtr head) {
+  client_->OnReceiveResponse(std::move(head));
 }
 
-void URLPipeLoader::OnDataReceived(base::StringPiece string_piece,
-                                   base::OnceClosure resume) {
-  producer_->Write(
-      std::make_unique<mojo::StringDataSource>(
-          string_piece, mojo::StringDataSource::AsyncWritingMode::
-                            STRING_STAYS_VALID_UNTIL_COMPLETION),
-      base::BindOnce(&URLPipeLoader::OnWrite, weak_factory_.GetWeakPtr(),
-                     std::move(resume)));
+void URLPipeLoader::OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                                      network::mojom::URLResponseHeadPtr head) {
+  // The client asked for the URL of the protocol handler, so redirects of the
+  // upstream request are not exposed to it.
+  upstream_loader_->FollowRedirect({}, {}, {}, absl::nullopt);
 }
 
-void URLPipeLoader::OnRetry(base::OnceClosure start_retry) {
-  NOTREACHED();
+void URLPipeLoader::OnUploadProgress(int64_t current_position,
+                                     int64_t total_size,
+                                     OnUploadProgressCallback callback) {
+  client_->OnUploadProgress(current_position, total_size, std::move(callback));
 }
 
-void URLPipeLoader::OnComplete(bool success) {
-  NotifyComplete(loader_->NetError());
+void URLPipeLoader::OnReceiveCachedMetadata(mojo_base::BigBuffer data) {
+  client_->OnReceiveCachedMetadata(std::move(data));
+}
+
+void URLPipeLoader::OnTransferSizeUpdated(int32_t transfer_size_diff) {
+  client_->OnTransferSizeUpdated(transfer_size_diff);
+}
+
+void URLPipeLoader::OnStartLoadingResponseBody(
+    mojo::ScopedDataPipeConsumerHandle body) {
+  client_->OnStartLoadingResponseBody(std::move(body));
+}
+
+void URLPipeLoader::OnComplete(
+    const network::URLLoaderCompletionStatus& status) {
+  client_->OnComplete(status);
+  delete this;
 }
 
 }  // namespace electron
@@ -9,12 +9,13 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "mojo/public/cpp/system/data_pipe_producer.h"
-#include "services/network/public/cpp/simple_url_loader.h"
-#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
 
 namespace network {
 class SharedURLLoaderFactory;
@@ -22,40 +23,32 @@ class SharedURLLoaderFactory;
 
 namespace electron {
 
-// Read data from URL and pipe it to NetworkService.
+// Load a URL and pipe its response to NetworkService.
 //
 // Different from creating a new loader for the URL directly, protocol handlers
 // using this loader can work around CORS restrictions.
 //
+// The upstream loader is driven directly, its response body pipe is handed to
+// the client as is and redirects are followed without involving the client.
+//
 // This class manages its own lifetime and should delete itself when the
 // connection is lost or finished.
 class URLPipeLoader : public network::mojom::URLLoader,
-                      public network::SimpleURLLoaderStreamConsumer {
+                      public network::mojom::URLLoaderClient {
  public:
   URLPipeLoader(scoped_refptr<network::SharedURLLoaderFactory> factory,
                 std::unique_ptr<network::ResourceRequest> request,
                 mojo::PendingReceiver<network::mojom::URLLoader> loader,
                 mojo::PendingRemote<network::mojom::URLLoaderClient> client,
-                const net::NetworkTrafficAnnotationTag& annotation,
-                base::DictionaryValue upload_data);
+                const net::MutableNetworkTrafficAnnotationTag& annotation);
 
  private:
   ~URLPipeLoader() override;
 
   void Start(scoped_refptr<network::SharedURLLoaderFactory> factory,
              std::unique_ptr<network::ResourceRequest> request,
-             const net::NetworkTrafficAnnotationTag& annotation,
-             base::DictionaryValue upload_data);
+             const net::MutableNetworkTrafficAnnotationTag& annotation);
   void NotifyComplete(int result);
-  void OnResponseStarted(const GURL& final_url,
-                         const network::mojom::URLResponseHead& response_head);
-  void OnWrite(base::OnceClosure resume, MojoResult result);
-
-  // SimpleURLLoaderStreamConsumer:
-  void OnDataReceived(base::StringPiece string_piece,
-                      base::OnceClosure resume) override;
-  void OnComplete(bool success) override;
-  void OnRetry(base::OnceClosure start_retry) override;
 
   // URLLoader:
   void FollowRedirect(
@@ -64,15 +57,29 @@ class URLPipeLoader : public network::mojom::URLLoader,
       const net::HttpRequestHeaders& modified_cors_exempt_headers,
       const absl::optional<GURL>& new_url) override {}
   void SetPriority(net::RequestPriority priority,
-                   int32_t intra_priority_value) override {}
-  void PauseReadingBodyFromNet() override {}
-  void ResumeReadingBodyFromNet() override {}
+                   int32_t intra_priority_value) override;
+  void PauseReadingBodyFromNet() override;
+  void ResumeReadingBodyFromNet() override;
+
+  // URLLoaderClient:
+  void OnReceiveEarlyHints(network::mojom::EarlyHintsPtr early_hints) override;
+  void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override;
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override;
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override;
+  void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override;
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override;
+  void OnStartLoadingResponseBody(
+      mojo::ScopedDataPipeConsumerHandle body) override;
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override;
 
   mojo::Receiver<network::mojom::URLLoader> url_loader_;
   mojo::Remote<network::mojom::URLLoaderClient> client_;
 
-  std::unique_ptr<mojo::DataPipeProducer> producer_;
-  std::unique_ptr<network::SimpleURLLoader> loader_;
+  mojo::Remote<network::mojom::URLLoader> upstream_loader_;
+  mojo::Receiver<network::mojom::URLLoaderClient> upstream_client_{this};
 
   base::WeakPtrFactory<URLPipeLoader> weak_factory_{this};
 
@@ -692,6 +692,10 @@ gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
 
 void OffScreenRenderWidgetHostView::CompositeFrame(
     const gfx::Rect& damage_rect) {
+  // Video frames are delivered straight from the capturer.
+  if (IsVideoFrameMode())
+    return;
+
   HoldResize();
 
   gfx::Size size_in_pixels = SizeInPixels();
@@ -947,6 +951,20 @@ int OffScreenRenderWidgetHostView::GetFrameRate() const {
   return frame_rate_;
 }
 
+void OffScreenRenderWidgetHostView::SetVideoFormat(
+    media::VideoPixelFormat format,
+    const OnVideoFrameCallback& callback) {
+  if (parent_host_view_ || !video_consumer_)
+    return;
+
+  video_format_ = format;
+  video_consumer_->SetVideoFormat(format, callback);
+}
+
+bool OffScreenRenderWidgetHostView::IsVideoFrameMode() const {
+  return video_format_ != media::PIXEL_FORMAT_ARGB;
+}
+
 ui::Compositor* OffScreenRenderWidgetHostView::GetCompositor() const {
   return compositor_.get();
 }
@@ -979,6 +997,10 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
 }
 
 void OffScreenRenderWidgetHostView::Invalidate() {
+  if (IsVideoFrameMode()) {
+    video_consumer_->RequestRefreshFrame();
+    return;
+  }
   InvalidateBounds(gfx::Rect(GetRequestedRendererSize()));
 }
 
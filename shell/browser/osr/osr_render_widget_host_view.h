@@ -196,6 +196,12 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
 
+  // Only takes effect for hardware accelerated top-level views, popups are
+  // always painted as bitmaps since they are composited into their parent.
+  void SetVideoFormat(media::VideoPixelFormat format,
+                      const OnVideoFrameCallback& callback);
+  bool IsVideoFrameMode() const;
+
   ui::Compositor* GetCompositor() const;
   ui::Layer* GetRootLayer() const;
 
@@ -244,6 +250,8 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  media::VideoPixelFormat video_format_ = media::PIXEL_FORMAT_ARGB;
+
   base::Time last_time_ = base::Time::Now();
 
   gfx::Vector2dF last_scroll_offset_;
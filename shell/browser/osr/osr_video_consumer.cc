@@ -4,15 +4,32 @@
 
 #include "shell/browser/osr/osr_video_consumer.h"
 
+#include <iterator>
 #include <utility>
 
+#include "media/base/video_frame.h"
 #include "media/base/video_frame_metadata.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
 #include "shell/browser/osr/osr_render_widget_host_view.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
 #include "ui/gfx/skbitmap_operations.h"
 
 namespace electron {
 
+namespace {
+
+// viz can only capture into ARGB or I420, NV12 frames are derived from I420.
+media::VideoPixelFormat GetCaptureFormat(media::VideoPixelFormat format) {
+  return format == media::PIXEL_FORMAT_ARGB ? media::PIXEL_FORMAT_ARGB
+                                            : media::PIXEL_FORMAT_I420;
+}
+
+}  // namespace
+
+OffScreenVideoFrame::OffScreenVideoFrame() = default;
+
+OffScreenVideoFrame::~OffScreenVideoFrame() = default;
+
 OffScreenVideoConsumer::OffScreenVideoConsumer(
     OffScreenRenderWidgetHostView* view,
     OnPaintCallback callback)
@@ -49,6 +66,23 @@ void OffScreenVideoConsumer::SizeChanged() {
   video_capturer_->RequestRefreshFrame();
 }
 
+void OffScreenVideoConsumer::RequestRefreshFrame() {
+  video_capturer_->RequestRefreshFrame();
+}
+
+void OffScreenVideoConsumer::SetVideoFormat(
+    media::VideoPixelFormat format,
+    const OnVideoFrameCallback& callback) {
+  video_frame_callback_ = callback;
+  if (video_format_ == format)
+    return;
+
+  video_format_ = format;
+  video_capturer_->SetFormat(GetCaptureFormat(format),
+                             gfx::ColorSpace::CreateREC709());
+  video_capturer_->RequestRefreshFrame();
+}
+
 void OffScreenVideoConsumer::OnFrameCaptured(
     base::ReadOnlySharedMemoryRegion data,
     ::media::mojom::VideoFrameInfoPtr info,
@@ -81,6 +115,22 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     callbacks_remote->Done();
     return;
   }
+  // Frames that were in flight when the format changed are dropped.
+  if (info->pixel_format != GetCaptureFormat(video_format_)) {
+    callbacks_remote->Done();
+    return;
+  }
+
+  absl::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
+  if (!update_rect.has_value() || update_rect->IsEmpty()) {
+    update_rect = content_rect;
+  }
+
+  if (video_format_ != media::PIXEL_FORMAT_ARGB) {
+    DeliverVideoFrame(std::move(mapping), info, *update_rect,
+                      std::move(callbacks_remote));
+    return;
+  }
 
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
@@ -111,12 +161,61 @@ void OffScreenVideoConsumer::OnFrameCaptured(
       new FramePinner{std::move(mapping), callbacks_remote.Unbind()});
   bitmap.setImmutable();
 
-  absl::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
-  if (!update_rect.has_value() || update_rect->IsEmpty()) {
-    update_rect = content_rect;
+  callback_.Run(*update_rect, bitmap);
+}
+
+void OffScreenVideoConsumer::DeliverVideoFrame(
+    base::ReadOnlySharedMemoryMapping mapping,
+    const ::media::mojom::VideoFrameInfoPtr& info,
+    const gfx::Rect& update_rect,
+    mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks> callbacks) {
+  auto frame = std::make_unique<OffScreenVideoFrame>();
+  frame->format = video_format_;
+  frame->coded_size = info->coded_size;
+  frame->visible_rect = info->visible_rect;
+  frame->update_rect = update_rect;
+  frame->timestamp = info->timestamp;
+  frame->color_space = info->color_space;
+
+  // The I420 planes are laid out back to back in the shared memory region.
+  const auto* data = static_cast<const uint8_t*>(mapping.memory());
+  OffScreenVideoFrame::Plane i420_planes[3];
+  for (size_t plane = 0; plane < 3; ++plane) {
+    int stride = media::VideoFrame::RowBytes(plane, media::PIXEL_FORMAT_I420,
+                                             info->coded_size.width());
+    size_t size = stride * media::VideoFrame::Rows(
+                               plane, media::PIXEL_FORMAT_I420,
+                               info->coded_size.height());
+    i420_planes[plane] = {data, size, stride};
+    data += size;
   }
 
-  callback_.Run(*update_rect, bitmap);
+  if (video_format_ == media::PIXEL_FORMAT_NV12) {
+    // Only the chroma planes need to be interleaved, the Y plane is shared.
+    const auto& u = i420_planes[media::VideoFrame::kUPlane];
+    const auto& v = i420_planes[media::VideoFrame::kVPlane];
+    int uv_stride =
+        media::VideoFrame::RowBytes(media::VideoFrame::kUVPlane,
+                                    media::PIXEL_FORMAT_NV12,
+                                    info->coded_size.width());
+    int uv_rows = media::VideoFrame::Rows(media::VideoFrame::kUVPlane,
+                                          media::PIXEL_FORMAT_NV12,
+                                          info->coded_size.height());
+    frame->converted.resize(uv_stride * uv_rows);
+    libyuv::MergeUVPlane(u.data, u.stride, v.data, v.stride,
+                         frame->converted.data(), uv_stride,
+                         (info->coded_size.width() + 1) / 2, uv_rows);
+    frame->planes = {i420_planes[media::VideoFrame::kYPlane],
+                     {frame->converted.data(), frame->converted.size(),
+                      uv_stride}};
+  } else {
+    frame->planes.assign(std::begin(i420_planes), std::end(i420_planes));
+  }
+
+  frame->mapping = std::move(mapping);
+  frame->releaser = callbacks.Unbind();
+
+  video_frame_callback_.Run(std::move(frame));
 }
 
 void OffScreenVideoConsumer::OnStopped() {}
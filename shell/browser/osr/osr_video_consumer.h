@@ -7,11 +7,15 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "media/base/video_types.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
+#include "ui/gfx/color_space.h"
 
 namespace electron {
 
@@ -20,6 +24,40 @@ class OffScreenRenderWidgetHostView;
 typedef base::RepeatingCallback<void(const gfx::Rect&, const SkBitmap&)>
     OnPaintCallback;
 
+// A captured YUV frame. The planes point into the shared memory that viz
+// captured into (or into |converted| for planes that had to be rearranged),
+// which stays valid and is not recycled by the capturer for as long as the
+// frame is alive.
+struct OffScreenVideoFrame {
+  struct Plane {
+    const uint8_t* data;
+    size_t size;
+    int stride;
+  };
+
+  OffScreenVideoFrame();
+  ~OffScreenVideoFrame();
+
+  media::VideoPixelFormat format = media::PIXEL_FORMAT_UNKNOWN;
+  gfx::Size coded_size;
+  gfx::Rect visible_rect;
+  gfx::Rect update_rect;
+  base::TimeDelta timestamp;
+  gfx::ColorSpace color_space;
+  std::vector<Plane> planes;
+
+  base::ReadOnlySharedMemoryMapping mapping;
+  // Prevents FrameSinkVideoCapturer from recycling |mapping|.
+  mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      releaser;
+  std::vector<uint8_t> converted;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenVideoFrame);
+};
+
+typedef base::RepeatingCallback<void(std::unique_ptr<OffScreenVideoFrame>)>
+    OnVideoFrameCallback;
+
 class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
  public:
   OffScreenVideoConsumer(OffScreenRenderWidgetHostView* view,
@@ -29,6 +67,13 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   void SetActive(bool active);
   void SetFrameRate(int frame_rate);
   void SizeChanged();
+  void RequestRefreshFrame();
+
+  // Selects the format frames are delivered in. PIXEL_FORMAT_ARGB frames go
+  // to the paint callback, PIXEL_FORMAT_I420 and PIXEL_FORMAT_NV12 frames go
+  // to |callback| without being converted to RGB.
+  void SetVideoFormat(media::VideoPixelFormat format,
+                      const OnVideoFrameCallback& callback);
 
  private:
   // viz::mojom::FrameSinkVideoConsumer implementation.
@@ -42,8 +87,16 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   void OnLog(const std::string& message) override;
 
   bool CheckContentRect(const gfx::Rect& content_rect);
+  void DeliverVideoFrame(
+      base::ReadOnlySharedMemoryMapping mapping,
+      const ::media::mojom::VideoFrameInfoPtr& info,
+      const gfx::Rect& update_rect,
+      mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks);
 
   OnPaintCallback callback_;
+  OnVideoFrameCallback video_frame_callback_;
+  media::VideoPixelFormat video_format_ = media::PIXEL_FORMAT_ARGB;
 
   OffScreenRenderWidgetHostView* view_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -118,9 +118,12 @@ OffScreenWebContentsView::CreateViewForWidget(
         render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
+  auto* view = new OffScreenRenderWidgetHostView(
       transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
       nullptr, GetSize());
+  if (video_format_ != media::PIXEL_FORMAT_ARGB)
+    view->SetVideoFormat(video_format_, video_frame_callback_);
+  return view;
 }
 
 content::RenderWidgetHostViewBase*
@@ -207,6 +210,21 @@ int OffScreenWebContentsView::GetFrameRate() const {
   }
 }
 
+void OffScreenWebContentsView::SetVideoFormat(
+    media::VideoPixelFormat format,
+    const OnVideoFrameCallback& callback) {
+  auto* view = GetView();
+  video_format_ = format;
+  video_frame_callback_ = callback;
+  if (view != nullptr) {
+    view->SetVideoFormat(format, callback);
+  }
+}
+
+media::VideoPixelFormat OffScreenWebContentsView::GetVideoFormat() const {
+  return video_format_;
+}
+
 OffScreenRenderWidgetHostView* OffScreenWebContentsView::GetView() const {
   if (web_contents_) {
     return static_cast<OffScreenRenderWidgetHostView*>(
@@ -79,6 +79,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void SetVideoFormat(media::VideoPixelFormat format,
+                      const OnVideoFrameCallback& callback);
+  media::VideoPixelFormat GetVideoFormat() const;
 
  private:
 #if defined(OS_MAC)
@@ -93,7 +96,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
   const bool transparent_;
   bool painting_ = true;
   int frame_rate_ = 60;
+  media::VideoPixelFormat video_format_ = media::PIXEL_FORMAT_ARGB;
   OnPaintCallback callback_;
+  OnVideoFrameCallback video_frame_callback_;
 
   // Weak refs.
   content::WebContents* web_contents_ = nullptr;
@@ -8,10 +8,13 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/span.h"
+#include "base/files/file_util.h"
 #include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/printing/print_job_manager.h"
 #include "chrome/browser/printing/printer_query.h"
@@ -48,6 +51,25 @@ void StopWorker(int document_cookie) {
   }
 }
 
+bool WritePdfToFile(const base::FilePath& path,
+                    scoped_refptr<base::RefCountedMemory> data_bytes) {
+  // Written straight from the shared memory mapping, without an intermediate
+  // copy on the UI thread.
+  return base::WriteFile(
+      path, base::make_span(data_bytes->front(), data_bytes->size()));
+}
+
+void OnPdfWritten(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                  const base::FilePath& path,
+                  bool success) {
+  if (success) {
+    promise.Resolve(v8::Undefined(promise.isolate()));
+  } else {
+    promise.RejectWithErrorMessage("Failed to write PDF to " +
+                                   path.AsUTF8Unsafe());
+  }
+}
+
 }  // namespace
 
 PrintPreviewMessageHandler::PrintPreviewMessageHandler(
@@ -209,10 +231,13 @@ void PrintPreviewMessageHandler::PrintPreviewCancelled(int32_t document_cookie,
 
 void PrintPreviewMessageHandler::PrintToPDF(
     base::DictionaryValue options,
+    const base::FilePath& path,
     gin_helper::Promise<v8::Local<v8::Value>> promise) {
   int request_id;
   options.GetInteger(printing::kPreviewRequestID, &request_id);
   promise_map_.emplace(request_id, std::move(promise));
+  if (!path.empty())
+    output_paths_.emplace(request_id, path);
 
   auto* focused_frame = web_contents_->GetFocusedFrame();
   auto* rfh = focused_frame && focused_frame->HasSelection()
@@ -236,6 +261,7 @@ PrintPreviewMessageHandler::GetPromise(int request_id) {
 
   gin_helper::Promise<v8::Local<v8::Value>> promise = std::move(it->second);
   promise_map_.erase(it);
+  output_paths_.erase(request_id);
 
   return promise;
 }
@@ -245,6 +271,19 @@ void PrintPreviewMessageHandler::ResolvePromise(
     scoped_refptr<base::RefCountedMemory> data_bytes) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
+  auto path_it = output_paths_.find(request_id);
+  if (path_it != output_paths_.end()) {
+    base::FilePath path = path_it->second;
+    gin_helper::Promise<v8::Local<v8::Value>> promise = GetPromise(request_id);
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+        base::BindOnce(&WritePdfToFile, path, std::move(data_bytes)),
+        base::BindOnce(&OnPdfWritten, std::move(promise), path));
+    return;
+  }
+
   gin_helper::Promise<v8::Local<v8::Value>> promise = GetPromise(request_id);
 
   v8::Isolate* isolate = promise.isolate();
@@ -7,6 +7,7 @@
 
 #include <map>
 
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "components/printing/common/print.mojom.h"
@@ -30,7 +31,10 @@ class PrintPreviewMessageHandler
  public:
   ~PrintPreviewMessageHandler() override;
 
+  // When |path| is not empty the PDF is written to it instead of being
+  // resolved as a Buffer.
   void PrintToPDF(base::DictionaryValue options,
+                  const base::FilePath& path,
                   gin_helper::Promise<v8::Local<v8::Value>> promise);
 
  private:
@@ -84,6 +88,9 @@ class PrintPreviewMessageHandler
   using PromiseMap = std::map<int, gin_helper::Promise<v8::Local<v8::Value>>>;
   PromiseMap promise_map_;
 
+  // Requests whose output goes to a file instead of a Buffer.
+  std::map<int, base::FilePath> output_paths_;
+
   content::WebContents* web_contents_ = nullptr;
 
   mojo::AssociatedRemote<printing::mojom::PrintRenderFrame> print_render_frame_;
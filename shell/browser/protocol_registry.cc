@@ -16,7 +16,8 @@ ProtocolRegistry* ProtocolRegistry::FromBrowserContext(
   return static_cast<ElectronBrowserContext*>(context)->protocol_registry();
 }
 
-ProtocolRegistry::ProtocolRegistry() = default;
+ProtocolRegistry::ProtocolRegistry(ElectronBrowserContext* browser_context)
+    : browser_context_(browser_context) {}
 
 ProtocolRegistry::~ProtocolRegistry() = default;
 
@@ -60,7 +61,13 @@ bool ProtocolRegistry::IsProtocolRegistered(const std::string& scheme) {
 bool ProtocolRegistry::InterceptProtocol(ProtocolType type,
                                          const std::string& scheme,
                                          const ProtocolHandler& handler) {
-  return base::TryEmplace(intercept_handlers_, scheme, type, handler).second;
+  bool added =
+      base::TryEmplace(intercept_handlers_, scheme, type, handler).second;
+  // URLLoaderFactories created while nothing was intercepted bypass the
+  // proxy that implements interception, make them pick it up.
+  if (added && intercept_handlers_.size() == 1)
+    browser_context_->ResetURLLoaderFactories();
+  return added;
 }
 
 bool ProtocolRegistry::UninterceptProtocol(const std::string& scheme) {
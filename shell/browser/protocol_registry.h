@@ -16,6 +16,8 @@ class BrowserContext;
 
 namespace electron {
 
+class ElectronBrowserContext;
+
 class ProtocolRegistry {
  public:
   ~ProtocolRegistry();
@@ -47,7 +49,10 @@ class ProtocolRegistry {
  private:
   friend class ElectronBrowserContext;
 
-  ProtocolRegistry();
+  explicit ProtocolRegistry(ElectronBrowserContext* browser_context);
+
+  // Weak-ref, it owns us.
+  ElectronBrowserContext* browser_context_;
 
   HandlersMap handlers_;
   HandlersMap intercept_handlers_;
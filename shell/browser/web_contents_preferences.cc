@@ -10,7 +10,10 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/hash/hash.h"
+#include "base/json/json_writer.h"
 #include "base/memory/ptr_util.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
@@ -27,7 +30,6 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/process_util.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
-#include "third_party/blink/public/mojom/v8_cache_options.mojom.h"
 
 #if defined(OS_WIN)
 #include "ui/gfx/switches.h"
@@ -109,6 +111,80 @@ bool GetAsAutoplayPolicy(const base::Value* val,
   return false;
 }
 
+bool GetAsV8CacheOptions(const base::Value* val,
+                         base::StringPiece path,
+                         blink::mojom::V8CacheOptions* out) {
+  std::string v8_cache_options;
+  if (!GetAsString(val, path, &v8_cache_options))
+    return false;
+  if (v8_cache_options == "none") {
+    *out = blink::mojom::V8CacheOptions::kNone;
+  } else if (v8_cache_options == "code") {
+    *out = blink::mojom::V8CacheOptions::kCode;
+  } else if (v8_cache_options == "bypassHeatCheck") {
+    *out = blink::mojom::V8CacheOptions::kCodeWithoutHeatCheck;
+  } else if (v8_cache_options == "bypassHeatCheckAndEagerCompile") {
+    *out = blink::mojom::V8CacheOptions::kFullCodeWithoutHeatCheck;
+  } else {
+    *out = blink::mojom::V8CacheOptions::kDefault;
+  }
+  return true;
+}
+
+std::vector<std::string> GetAsStringList(const base::Value* val,
+                                         base::StringPiece path) {
+  std::vector<std::string> result;
+  auto* list = val->FindKeyOfType(path, base::Value::Type::LIST);
+  if (list) {
+    for (const auto& item : list->GetList()) {
+      if (item.is_string())
+        result.push_back(item.GetString());
+    }
+  }
+  return result;
+}
+
+bool GetAsPreloadPath(const base::Value* val, base::FilePath* path) {
+  base::FilePath::StringType preload_path;
+  if (GetAsString(val, electron::options::kPreloadScript, &preload_path)) {
+    base::FilePath preload(preload_path);
+    if (preload.IsAbsolute()) {
+      *path = std::move(preload);
+      return true;
+    } else {
+      LOG(ERROR) << "preload script must have absolute path.";
+    }
+  } else if (GetAsString(val, electron::options::kPreloadURL, &preload_path)) {
+    // Translate to file path if there is "preload-url" option.
+    base::FilePath preload;
+    GURL preload_url;
+#if defined(OS_WIN)
+    preload_url = GURL(base::WideToUTF8(preload_path));
+#else
+    preload_url = GURL(preload_path);
+#endif
+    if (net::FileURLToFilePath(preload_url, &preload)) {
+      *path = std::move(preload);
+      return true;
+    } else {
+      LOG(ERROR) << "preload url must be file:// protocol.";
+    }
+  }
+  return false;
+}
+
+template <typename T>
+absl::optional<T> GetOptional(bool (*getter)(const base::Value*,
+                                             base::StringPiece,
+                                             T*),
+                              const base::Value* val,
+                              base::StringPiece path) {
+  T out;
+  if (getter(val, path, &out))
+    return out;
+  return absl::nullopt;
+}
+
 }  // namespace
 
 namespace electron {
@@ -116,10 +192,21 @@ namespace electron {
 // static
 std::vector<WebContentsPreferences*> WebContentsPreferences::instances_;
 
+// static
+std::map<int, WebContentsPreferences*> WebContentsPreferences::process_index_;
+
+WebContentsPreferences::ParsedPreferences::ParsedPreferences() = default;
+WebContentsPreferences::ParsedPreferences::~ParsedPreferences() = default;
+WebContentsPreferences::ParsedPreferences::ParsedPreferences(
+    ParsedPreferences&&) = default;
+WebContentsPreferences::ParsedPreferences&
+WebContentsPreferences::ParsedPreferences::operator=(ParsedPreferences&&) =
+    default;
+
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const gin_helper::Dictionary& web_preferences)
-    : web_contents_(web_contents) {
+    : content::WebContentsObserver(web_contents), web_contents_(web_contents) {
   v8::Isolate* isolate = web_preferences.isolate();
   gin_helper::Dictionary copied(isolate, web_preferences.GetHandle()->Clone());
   // Following fields should not be stored.
@@ -131,6 +218,7 @@ WebContentsPreferences::WebContentsPreferences(
   web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
 
   instances_.push_back(this);
+  UpdateProcessIndex(web_contents->GetMainFrame());
 
   // Set WebPreferences defaults onto the JS object
   SetDefaultBoolIfUndefined(options::kPlugins, false);
@@ -138,6 +226,7 @@ WebContentsPreferences::WebContentsPreferences(
   SetDefaultBoolIfUndefined(options::kNodeIntegration, false);
   SetDefaultBoolIfUndefined(options::kNodeIntegrationInSubFrames, false);
   SetDefaultBoolIfUndefined(options::kNodeIntegrationInWorker, false);
+  SetDefaultBoolIfUndefined(options::kLazyNodeEnvironment, false);
   SetDefaultBoolIfUndefined(options::kDisableHtmlFullscreenWindowResize, false);
   SetDefaultBoolIfUndefined(options::kWebviewTag, false);
   SetDefaultBoolIfUndefined(options::kSandbox, false);
@@ -176,8 +265,7 @@ WebContentsPreferences::WebContentsPreferences(
       auto* embedder = manager->GetEmbedder(guest_instance_id);
       if (embedder) {
         auto* embedder_preferences = WebContentsPreferences::From(embedder);
-        if (embedder_preferences &&
-            embedder_preferences->IsEnabled(options::kOffscreen)) {
+        if (embedder_preferences && embedder_preferences->parsed().offscreen) {
           preference_.SetKey(options::kOffscreen, base::Value(true));
         }
       }
@@ -190,6 +278,8 @@ WebContentsPreferences::WebContentsPreferences(
 WebContentsPreferences::~WebContentsPreferences() {
   instances_.erase(std::remove(instances_.begin(), instances_.end(), this),
                    instances_.end());
+  base::EraseIf(process_index_,
+                [this](const auto& entry) { return entry.second == this; });
 }
 
 void WebContentsPreferences::SetDefaults() {
@@ -197,7 +287,100 @@ void WebContentsPreferences::SetDefaults() {
     SetBool(options::kNativeWindowOpen, true);
   }
 
-  last_preference_ = preference_.Clone();
+  ParsePreferences();
+  SaveLastPreferences();
+}
+
+void WebContentsPreferences::ParsePreferences() {
+  const base::Value* prefs = &preference_;
+  ParsedPreferences parsed;
+
+  parsed.context_isolation = IsEnabled(options::kContextIsolation, true);
+  parsed.disable_dialogs = IsEnabled("disableDialogs");
+  parsed.disable_html_fullscreen_window_resize =
+      IsEnabled(options::kDisableHtmlFullscreenWindowResize);
+  parsed.disable_popups = IsEnabled("disablePopups");
+  parsed.enable_preferred_size_mode =
+      IsEnabled(options::kEnablePreferredSizeMode);
+  parsed.enable_websql = IsEnabled(options::kEnableWebSQL);
+  parsed.experimental_features = IsEnabled(options::kExperimentalFeatures);
+  parsed.ignore_menu_shortcuts = IsEnabled("ignoreMenuShortcuts");
+  parsed.images = IsEnabled(options::kImages, true);
+  parsed.javascript = IsEnabled(options::kJavaScript, true);
+  parsed.lazy_node_environment = IsEnabled(options::kLazyNodeEnvironment);
+  parsed.navigate_on_drag_drop = IsEnabled(options::kNavigateOnDragDrop);
+  parsed.node_integration = IsEnabled(options::kNodeIntegration);
+  parsed.node_integration_in_sub_frames =
+      IsEnabled(options::kNodeIntegrationInSubFrames);
+  parsed.node_integration_in_worker =
+      IsEnabled(options::kNodeIntegrationInWorker);
+  parsed.offscreen = IsEnabled(options::kOffscreen);
+  parsed.plugins = IsEnabled(options::kPlugins);
+  parsed.sandbox = IsEnabled(options::kSandbox);
+#if defined(OS_MAC)
+  parsed.scroll_bounce = IsEnabled(options::kScrollBounce);
+#endif
+#if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
+  parsed.spellcheck = IsEnabled(options::kSpellcheck);
+#endif
+  parsed.text_areas_are_resizable =
+      IsEnabled(options::kTextAreasAreResizable, true);
+  parsed.web_security = IsEnabled(options::kWebSecurity, true);
+  parsed.allow_running_insecure_content = IsEnabled(
+      options::kAllowRunningInsecureContent, !parsed.web_security);
+  parsed.webgl = IsEnabled(options::kWebGL, true);
+  parsed.webview_tag = IsEnabled(options::kWebviewTag);
+  auto* native_window_open = prefs->FindKeyOfType(
+      options::kNativeWindowOpen, base::Value::Type::BOOLEAN);
+  if (native_window_open)
+    parsed.native_window_open = native_window_open->GetBool();
+
+  GetAsInteger(prefs, options::kGuestInstanceID, &parsed.guest_instance_id);
+  parsed.opener_id = GetOptional(&GetAsInteger, prefs, options::kOpenerID);
+  parsed.default_font_size =
+      GetOptional(&GetAsInteger, prefs, "defaultFontSize");
+  parsed.default_monospace_font_size =
+      GetOptional(&GetAsInteger, prefs, "defaultMonospaceFontSize");
+  parsed.minimum_font_size =
+      GetOptional(&GetAsInteger, prefs, "minimumFontSize");
+
+  using StringGetter =
+      bool (*)(const base::Value*, base::StringPiece, std::string*);
+  StringGetter get_string = &GetAsString;
+  parsed.background_color =
+      GetOptional(get_string, prefs, options::kBackgroundColor);
+  parsed.default_encoding = GetOptional(get_string, prefs, "defaultEncoding");
+  parsed.enable_blink_features =
+      GetOptional(get_string, prefs, options::kEnableBlinkFeatures);
+  parsed.disable_blink_features =
+      GetOptional(get_string, prefs, options::kDisableBlinkFeatures);
+  base::FilePath preload_path;
+  if (GetAsPreloadPath(prefs, &preload_path))
+    parsed.preload_path = std::move(preload_path);
+  parsed.autoplay_policy =
+      GetOptional(&GetAsAutoplayPolicy, prefs, "autoplayPolicy");
+  parsed.v8_cache_options =
+      GetOptional(&GetAsV8CacheOptions, prefs, "v8CacheOptions");
+
+  auto* fonts_dict =
+      prefs->FindKeyOfType("defaultFontFamily", base::Value::Type::DICTIONARY);
+  if (fonts_dict) {
+    for (const char* family : {"standard", "serif", "sansSerif", "monospace",
+                               "cursive", "fantasy"}) {
+      std::u16string font;
+      if (GetAsString(fonts_dict, family, &font))
+        parsed.default_font_family[family] = std::move(font);
+    }
+  }
+
+  parsed.custom_args = GetAsStringList(prefs, options::kCustomArgs);
+  parsed.command_line_switches = GetAsStringList(prefs, "commandLineSwitches");
+
+  parsed_ = std::move(parsed);
+
+  std::string json;
+  base::JSONWriter::Write(preference_, &json);
+  fingerprint_ = base::PersistentHash(json);
 }
 
 bool WebContentsPreferences::IsUndefined(base::StringPiece key) {
@@ -239,6 +422,18 @@ void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
 void WebContentsPreferences::Clear() {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->Clear();
+
+  ParsePreferences();
+}
+
+void WebContentsPreferences::SetBackgroundColor(const std::string& color) {
+  preference_.SetStringKey(options::kBackgroundColor, color);
+  ParsePreferences();
+}
+
+void WebContentsPreferences::SetIgnoreMenuShortcuts(bool ignore) {
+  SetBool("ignoreMenuShortcuts", ignore);
+  ParsePreferences();
 }
 
 bool WebContentsPreferences::GetPreference(base::StringPiece name,
@@ -248,41 +443,53 @@ bool WebContentsPreferences::GetPreference(base::StringPiece name,
 
 bool WebContentsPreferences::GetPreloadPath(base::FilePath* path) const {
   DCHECK(path);
-  base::FilePath::StringType preload_path;
-  if (GetAsString(&preference_, options::kPreloadScript, &preload_path)) {
-    base::FilePath preload(preload_path);
-    if (preload.IsAbsolute()) {
-      *path = std::move(preload);
-      return true;
-    } else {
-      LOG(ERROR) << "preload script must have absolute path.";
-    }
-  } else if (GetAsString(&preference_, options::kPreloadURL, &preload_path)) {
-    // Translate to file path if there is "preload-url" option.
-    base::FilePath preload;
-    GURL preload_url;
-#if defined(OS_WIN)
-    preload_url = GURL(base::WideToUTF8(preload_path));
-#else
-    preload_url = GURL(preload_path);
-#endif
-    if (net::FileURLToFilePath(preload_url, &preload)) {
-      *path = std::move(preload);
-      return true;
-    } else {
-      LOG(ERROR) << "preload url must be file:// protocol.";
-    }
-  }
-  return false;
+  if (!parsed_.preload_path)
+    return false;
+  *path = *parsed_.preload_path;
+  return true;
+}
+
+void WebContentsPreferences::RenderFrameHostChanged(
+    content::RenderFrameHost* old_host,
+    content::RenderFrameHost* new_host) {
+  if (new_host && !new_host->GetParent())
+    UpdateProcessIndex(new_host);
+}
+
+void WebContentsPreferences::UpdateProcessIndex(
+    content::RenderFrameHost* main_frame) {
+  int process_id = main_frame->GetProcess()->GetID();
+  auto iter = process_index_.find(process_id);
+  // Keep an entry that is still valid, so that a process shared by several
+  // WebContents keeps resolving to the same one.
+  if (iter != process_index_.end() &&
+      iter->second->web_contents_->GetMainFrame()->GetProcess()->GetID() ==
+          process_id)
+    return;
+  process_index_[process_id] = this;
 }
 
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     int process_id) {
+  // Entries go stale when a main frame moves to another process, so they are
+  // checked before being trusted.
+  auto iter = process_index_.find(process_id);
+  if (iter != process_index_.end()) {
+    content::WebContents* web_contents = iter->second->web_contents_;
+    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id)
+      return web_contents;
+    process_index_.erase(iter);
+  }
+
+  // Processes without any main frame, e.g. for ServiceWorkers, are never
+  // indexed and take the slow path.
   for (WebContentsPreferences* preferences : instances_) {
     content::WebContents* web_contents = preferences->web_contents_;
-    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id)
+    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id) {
+      process_index_[process_id] = preferences;
       return web_contents;
+    }
   }
   return nullptr;
 }
@@ -299,16 +506,16 @@ void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
   // Experimental flags.
-  if (IsEnabled(options::kExperimentalFeatures))
+  if (parsed_.experimental_features)
     command_line->AppendSwitch(
         ::switches::kEnableExperimentalWebPlatformFeatures);
 
   // Sandbox can be enabled for renderer processes hosting cross-origin frames
   // unless nodeIntegrationInSubFrames is enabled
   bool can_sandbox_frame =
-      is_subframe && !IsEnabled(options::kNodeIntegrationInSubFrames);
+      is_subframe && !parsed_.node_integration_in_sub_frames;
 
-  if (IsEnabled(options::kSandbox) || can_sandbox_frame) {
+  if (parsed_.sandbox || can_sandbox_frame) {
     command_line->AppendSwitch(switches::kEnableSandbox);
   } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
     command_line->AppendSwitch(sandbox::policy::switches::kNoSandbox);
@@ -316,127 +523,108 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Custom args for renderer process
-  auto* customArgs =
-      preference_.FindKeyOfType(options::kCustomArgs, base::Value::Type::LIST);
-  if (customArgs) {
-    for (const auto& customArg : customArgs->GetList()) {
-      if (customArg.is_string())
-        command_line->AppendArg(customArg.GetString());
-    }
-  }
+  for (const auto& customArg : parsed_.custom_args)
+    command_line->AppendArg(customArg);
 
 #if defined(OS_MAC)
   // Enable scroll bounce.
-  if (IsEnabled(options::kScrollBounce))
+  if (parsed_.scroll_bounce)
     command_line->AppendSwitch(switches::kScrollBounce);
 #endif
 
   // Custom command line switches.
-  auto* args =
-      preference_.FindKeyOfType("commandLineSwitches", base::Value::Type::LIST);
-  if (args) {
-    for (const auto& arg : args->GetList()) {
-      if (arg.is_string()) {
-        const auto& arg_val = arg.GetString();
-        if (!arg_val.empty())
-          command_line->AppendSwitch(arg_val);
-      }
-    }
+  for (const auto& arg_val : parsed_.command_line_switches) {
+    if (!arg_val.empty())
+      command_line->AppendSwitch(arg_val);
   }
 
-  std::string s;
   // Enable blink features.
-  if (GetAsString(&preference_, options::kEnableBlinkFeatures, &s))
-    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures, s);
+  if (parsed_.enable_blink_features)
+    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures,
+                                    *parsed_.enable_blink_features);
 
   // Disable blink features.
-  if (GetAsString(&preference_, options::kDisableBlinkFeatures, &s))
-    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures, s);
+  if (parsed_.disable_blink_features)
+    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures,
+                                    *parsed_.disable_blink_features);
 
-  if (IsEnabled(options::kNodeIntegrationInWorker))
+  if (parsed_.node_integration_in_worker)
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
   // We are appending args to a webContents so let's save the current state
   // of our preferences object so that during the lifetime of the WebContents
   // we can fetch the options used to initally configure the WebContents
+  SaveLastPreferences();
+}
+
+void WebContentsPreferences::SaveLastPreferences() {
+  // This runs for every renderer process of the WebContents while the
+  // preferences rarely change, so the fingerprints let a changed set skip
+  // the deep comparison and the deep comparison lets an unchanged set skip
+  // the copy.
+  if (fingerprint_ == last_fingerprint_ && preference_ == last_preference_)
+    return;
   last_preference_ = preference_.Clone();
+  last_fingerprint_ = fingerprint_;
 }
 
 void WebContentsPreferences::OverrideWebkitPrefs(
     blink::web_pref::WebPreferences* prefs) {
-  prefs->javascript_enabled =
-      IsEnabled(options::kJavaScript, true /* default_value */);
-  prefs->images_enabled = IsEnabled(options::kImages, true /* default_value */);
-  prefs->text_areas_are_resizable =
-      IsEnabled(options::kTextAreasAreResizable, true /* default_value */);
-  prefs->navigate_on_drag_drop =
-      IsEnabled(options::kNavigateOnDragDrop, false /* default_value */);
-  if (!GetAsAutoplayPolicy(&preference_, "autoplayPolicy",
-                           &prefs->autoplay_policy)) {
-    prefs->autoplay_policy =
-        blink::mojom::AutoplayPolicy::kNoUserGestureRequired;
-  }
+  prefs->javascript_enabled = parsed_.javascript;
+  prefs->images_enabled = parsed_.images;
+  prefs->text_areas_are_resizable = parsed_.text_areas_are_resizable;
+  prefs->navigate_on_drag_drop = parsed_.navigate_on_drag_drop;
+  prefs->autoplay_policy = parsed_.autoplay_policy.value_or(
+      blink::mojom::AutoplayPolicy::kNoUserGestureRequired);
 
   // Check if webgl should be enabled.
-  bool is_webgl_enabled = IsEnabled(options::kWebGL, true /* default_value */);
-  prefs->webgl1_enabled = is_webgl_enabled;
-  prefs->webgl2_enabled = is_webgl_enabled;
+  prefs->webgl1_enabled = parsed_.webgl;
+  prefs->webgl2_enabled = parsed_.webgl;
 
   // Check if web security should be enabled.
-  bool is_web_security_enabled =
-      IsEnabled(options::kWebSecurity, true /* default_value */);
-  prefs->web_security_enabled = is_web_security_enabled;
+  prefs->web_security_enabled = parsed_.web_security;
   prefs->allow_running_insecure_content =
-      IsEnabled(options::kAllowRunningInsecureContent,
-                !is_web_security_enabled /* default_value */);
-
-  auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
-                                               base::Value::Type::DICTIONARY);
-  if (fonts_dict) {
-    std::u16string font;
-    if (GetAsString(fonts_dict, "standard", &font))
-      prefs->standard_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "serif", &font))
-      prefs->serif_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "sansSerif", &font))
-      prefs->sans_serif_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "monospace", &font))
-      prefs->fixed_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "cursive", &font))
-      prefs->cursive_font_family_map[blink::web_pref::kCommonScript] = font;
-    if (GetAsString(fonts_dict, "fantasy", &font))
-      prefs->fantasy_font_family_map[blink::web_pref::kCommonScript] = font;
-  }
-
-  int size;
-  if (GetAsInteger(&preference_, "defaultFontSize", &size))
-    prefs->default_font_size = size;
-  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &size))
-    prefs->default_fixed_font_size = size;
-  if (GetAsInteger(&preference_, "minimumFontSize", &size))
-    prefs->minimum_font_size = size;
-  std::string encoding;
-  if (GetAsString(&preference_, "defaultEncoding", &encoding))
-    prefs->default_encoding = encoding;
+      parsed_.allow_running_insecure_content;
+
+  const auto& fonts = parsed_.default_font_family;
+  auto set_font = [&fonts](const char* family,
+                           blink::web_pref::ScriptFontFamilyMap* map) {
+    auto iter = fonts.find(family);
+    if (iter != fonts.end())
+      (*map)[blink::web_pref::kCommonScript] = iter->second;
+  };
+  set_font("standard", &prefs->standard_font_family_map);
+  set_font("serif", &prefs->serif_font_family_map);
+  set_font("sansSerif", &prefs->sans_serif_font_family_map);
+  set_font("monospace", &prefs->fixed_font_family_map);
+  set_font("cursive", &prefs->cursive_font_family_map);
+  set_font("fantasy", &prefs->fantasy_font_family_map);
+
+  if (parsed_.default_font_size)
+    prefs->default_font_size = *parsed_.default_font_size;
+  if (parsed_.default_monospace_font_size)
+    prefs->default_fixed_font_size = *parsed_.default_monospace_font_size;
+  if (parsed_.minimum_font_size)
+    prefs->minimum_font_size = *parsed_.minimum_font_size;
+  if (parsed_.default_encoding)
+    prefs->default_encoding = *parsed_.default_encoding;
 
   // --background-color.
-  std::string color;
-  if (GetAsString(&preference_, options::kBackgroundColor, &color)) {
-    prefs->background_color = color;
-  } else if (!IsEnabled(options::kOffscreen)) {
+  if (parsed_.background_color) {
+    prefs->background_color = *parsed_.background_color;
+  } else if (!parsed_.offscreen) {
     prefs->background_color = "#fff";
   }
 
   // Pass the opener's window id.
-  int opener_id;
-  if (GetAsInteger(&preference_, options::kOpenerID, &opener_id))
-    prefs->opener_id = opener_id;
+  if (parsed_.opener_id)
+    prefs->opener_id = *parsed_.opener_id;
 
   // Run Electron APIs and preload script in isolated world
-  prefs->context_isolation = IsEnabled(options::kContextIsolation, true);
+  prefs->context_isolation = parsed_.context_isolation;
 
-  int guest_instance_id = 0;
-  if (GetAsInteger(&preference_, options::kGuestInstanceID, &guest_instance_id))
+  int guest_instance_id = parsed_.guest_instance_id;
+  if (guest_instance_id)
     prefs->guest_instance_id = guest_instance_id;
 
   prefs->hidden_page = false;
@@ -461,53 +649,41 @@ void WebContentsPreferences::OverrideWebkitPrefs(
     }
   }
 
-  prefs->offscreen = IsEnabled(options::kOffscreen);
+  prefs->offscreen = parsed_.offscreen;
 
   // The preload script.
-  GetPreloadPath(&prefs->preload);
+  if (parsed_.preload_path)
+    prefs->preload = *parsed_.preload_path;
 
   // Check if nativeWindowOpen is enabled.
-  prefs->native_window_open = IsEnabled(options::kNativeWindowOpen, true);
+  prefs->native_window_open = parsed_.native_window_open.value_or(true);
 
   // Check if we have node integration specified.
-  prefs->node_integration = IsEnabled(options::kNodeIntegration);
+  prefs->node_integration = parsed_.node_integration;
 
   // Whether to enable node integration in Worker.
-  prefs->node_integration_in_worker =
-      IsEnabled(options::kNodeIntegrationInWorker);
+  prefs->node_integration_in_worker = parsed_.node_integration_in_worker;
 
   prefs->node_integration_in_sub_frames =
-      IsEnabled(options::kNodeIntegrationInSubFrames);
+      parsed_.node_integration_in_sub_frames;
+
+  prefs->lazy_node_environment = parsed_.lazy_node_environment;
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
-  prefs->enable_spellcheck = IsEnabled(options::kSpellcheck);
+  prefs->enable_spellcheck = parsed_.spellcheck;
 #endif
 
   // Check if plugins are enabled.
-  prefs->enable_plugins = IsEnabled(options::kPlugins);
+  prefs->enable_plugins = parsed_.plugins;
 
   // Check if webview tag creation is enabled, default to nodeIntegration value.
-  prefs->webview_tag = IsEnabled(options::kWebviewTag);
+  prefs->webview_tag = parsed_.webview_tag;
 
   // Whether to allow the WebSQL api
-  prefs->enable_websql = IsEnabled(options::kEnableWebSQL);
+  prefs->enable_websql = parsed_.enable_websql;
 
-  std::string v8_cache_options;
-  if (GetAsString(&preference_, "v8CacheOptions", &v8_cache_options)) {
-    if (v8_cache_options == "none") {
-      prefs->v8_cache_options = blink::mojom::V8CacheOptions::kNone;
-    } else if (v8_cache_options == "code") {
-      prefs->v8_cache_options = blink::mojom::V8CacheOptions::kCode;
-    } else if (v8_cache_options == "bypassHeatCheck") {
-      prefs->v8_cache_options =
-          blink::mojom::V8CacheOptions::kCodeWithoutHeatCheck;
-    } else if (v8_cache_options == "bypassHeatCheckAndEagerCompile") {
-      prefs->v8_cache_options =
-          blink::mojom::V8CacheOptions::kFullCodeWithoutHeatCheck;
-    } else {
-      prefs->v8_cache_options = blink::mojom::V8CacheOptions::kDefault;
-    }
-  }
+  if (parsed_.v8_cache_options)
+    prefs->v8_cache_options = *parsed_.v8_cache_options;
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsPreferences)
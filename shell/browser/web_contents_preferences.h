@@ -5,11 +5,17 @@
 #ifndef SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 #define SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/values.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/public/mojom/v8_cache_options.mojom.h"
+#include "third_party/blink/public/mojom/webpreferences/web_preferences.mojom.h"
 
 namespace base {
 class CommandLine;
@@ -27,8 +33,66 @@ namespace electron {
 
 // Stores and applies the preferences of WebContents.
 class WebContentsPreferences
-    : public content::WebContentsUserData<WebContentsPreferences> {
+    : public content::WebContentsUserData<WebContentsPreferences>,
+      public content::WebContentsObserver {
  public:
+  // The preferences read by the browser process, parsed once from the
+  // dictionary whenever it changes. Members hold the value that applies
+  // when the preference is not set.
+  struct ParsedPreferences {
+    ParsedPreferences();
+    ~ParsedPreferences();
+    ParsedPreferences(ParsedPreferences&&);
+    ParsedPreferences& operator=(ParsedPreferences&&);
+
+    bool allow_running_insecure_content = false;
+    bool context_isolation = true;
+    bool disable_dialogs = false;
+    bool disable_html_fullscreen_window_resize = false;
+    bool disable_popups = false;
+    bool enable_preferred_size_mode = false;
+    bool enable_websql = false;
+    bool experimental_features = false;
+    bool ignore_menu_shortcuts = false;
+    bool images = true;
+    bool javascript = true;
+    bool lazy_node_environment = false;
+    bool navigate_on_drag_drop = false;
+    bool node_integration = false;
+    bool node_integration_in_sub_frames = false;
+    bool node_integration_in_worker = false;
+    bool offscreen = false;
+    bool plugins = false;
+    bool sandbox = false;
+    bool scroll_bounce = false;
+    bool spellcheck = false;
+    bool text_areas_are_resizable = true;
+    bool web_security = true;
+    bool webgl = true;
+    bool webview_tag = false;
+    // Kept unresolved, callers disagree on its default.
+    absl::optional<bool> native_window_open;
+
+    int guest_instance_id = 0;
+    absl::optional<int> opener_id;
+    absl::optional<int> default_font_size;
+    absl::optional<int> default_monospace_font_size;
+    absl::optional<int> minimum_font_size;
+
+    absl::optional<std::string> background_color;
+    absl::optional<std::string> default_encoding;
+    absl::optional<std::string> enable_blink_features;
+    absl::optional<std::string> disable_blink_features;
+    absl::optional<base::FilePath> preload_path;
+    absl::optional<blink::mojom::AutoplayPolicy> autoplay_policy;
+    absl::optional<blink::mojom::V8CacheOptions> v8_cache_options;
+
+    // defaultFontFamily, keyed by generic family name.
+    std::map<std::string, std::u16string> default_font_family;
+    std::vector<std::string> custom_args;
+    std::vector<std::string> command_line_switches;
+  };
+
   // Get self from WebContents.
   static WebContentsPreferences* From(content::WebContents* web_contents);
 
@@ -61,17 +125,37 @@ class WebContentsPreferences
   // Returns the preload script path.
   bool GetPreloadPath(base::FilePath* path) const;
 
+  // Setters for the preferences that can change after creation.
+  void SetBackgroundColor(const std::string& color);
+  void SetIgnoreMenuShortcuts(bool ignore);
+
   // Returns the web preferences.
-  base::Value* preference() { return &preference_; }
-  base::Value* last_preference() { return &last_preference_; }
+  const base::Value* preference() const { return &preference_; }
+  const base::Value* last_preference() const { return &last_preference_; }
+
+  const ParsedPreferences& parsed() const { return parsed_; }
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
   friend class ElectronBrowserClient;
 
+  // content::WebContentsObserver:
+  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
+                              content::RenderFrameHost* new_host) override;
+
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  // Records the process of the main frame in |process_index_|.
+  void UpdateProcessIndex(content::RenderFrameHost* main_frame);
+
+  // Rebuilds |parsed_| and |fingerprint_| from |preference_|.
+  void ParsePreferences();
+
+  // Snapshots the preferences into |last_preference_| unless they are
+  // unchanged since the last snapshot.
+  void SaveLastPreferences();
+
   // Checks if the key is not defined
   bool IsUndefined(base::StringPiece key);
 
@@ -83,11 +167,21 @@ class WebContentsPreferences
 
   static std::vector<WebContentsPreferences*> instances_;
 
+  // Process ID => the last known instance whose main frame is hosted in it.
+  static std::map<int, WebContentsPreferences*> process_index_;
+
   content::WebContents* web_contents_;
 
   base::Value preference_ = base::Value(base::Value::Type::DICTIONARY);
   base::Value last_preference_ = base::Value(base::Value::Type::DICTIONARY);
 
+  // Hashes of |preference_| and |last_preference_|. Differing fingerprints
+  // mean differing preferences.
+  uint32_t fingerprint_ = 0;
+  uint32_t last_fingerprint_ = 0;
+
+  ParsedPreferences parsed_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsPreferences);
@@ -14,6 +14,7 @@
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "gin/arguments.h"
 #include "gin/object_template_builder.h"
@@ -28,11 +29,14 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
 #include "ui/base/layout.h"
 #include "ui/base/webui/web_ui_util.h"
 #include "ui/gfx/codec/jpeg_codec.h"
@@ -78,6 +82,99 @@ base::FilePath NormalizePath(const base::FilePath& path) {
   }
 }
 
+// Hands |encoded| over to a Buffer without copying it.
+v8::Local<v8::Value> AdoptEncodedData(
+    v8::Isolate* isolate,
+    std::unique_ptr<std::vector<unsigned char>> encoded) {
+  if (encoded->empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  auto* data = reinterpret_cast<char*>(encoded->data());
+  size_t size = encoded->size();
+  return node::Buffer::New(
+             isolate, data, size,
+             [](char* data, void* hint) {
+               delete static_cast<std::vector<unsigned char>*>(hint);
+             },
+             encoded.release())
+      .ToLocalChecked();
+}
+
+enum class ImageFormat { kPNG, kJPEG, kWebP };
+
+struct EncodeOptions {
+  ImageFormat format = ImageFormat::kPNG;
+  int quality = 90;
+  bool lossless = false;
+  bool fast = false;
+};
+
+class VectorWStream : public SkWStream {
+ public:
+  explicit VectorWStream(std::vector<unsigned char>* dst) : dst_(dst) {}
+
+  bool write(const void* buffer, size_t size) override {
+    const auto* bytes = static_cast<const unsigned char*>(buffer);
+    dst_->insert(dst_->end(), bytes, bytes + size);
+    return true;
+  }
+
+  size_t bytesWritten() const override { return dst_->size(); }
+
+ private:
+  std::vector<unsigned char>* dst_;
+};
+
+// Runs on the thread pool, returns nullptr on failure.
+std::unique_ptr<std::vector<unsigned char>> EncodeBitmap(
+    const SkBitmap& bitmap,
+    const EncodeOptions& options) {
+  auto encoded = std::make_unique<std::vector<unsigned char>>();
+  bool success = false;
+  switch (options.format) {
+    case ImageFormat::kPNG:
+      success =
+          options.fast
+              ? gfx::PNGCodec::FastEncodeBGRASkBitmap(bitmap, false,
+                                                      encoded.get())
+              : gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, encoded.get());
+      break;
+    case ImageFormat::kJPEG:
+      success = gfx::JPEGCodec::Encode(bitmap, options.quality, encoded.get());
+      break;
+    case ImageFormat::kWebP: {
+      SkPixmap pixmap;
+      if (!bitmap.peekPixels(&pixmap))
+        break;
+      SkWebpEncoder::Options webp_options;
+      webp_options.fCompression = options.lossless
+                                      ? SkWebpEncoder::Compression::kLossless
+                                      : SkWebpEncoder::Compression::kLossy;
+      // For lossless images the quality is the effort spent compressing.
+      webp_options.fQuality = options.lossless && options.fast
+                                  ? 0
+                                  : static_cast<float>(options.quality);
+      VectorWStream stream(encoded.get());
+      success = SkWebpEncoder::Encode(&stream, pixmap, webp_options);
+      break;
+    }
+  }
+  if (!success)
+    return nullptr;
+  return encoded;
+}
+
+void OnBitmapEncoded(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                     std::unique_ptr<std::vector<unsigned char>> encoded) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  if (!encoded) {
+    promise.RejectWithErrorMessage("Failed to encode image");
+    return;
+  }
+  promise.Resolve(AdoptEncodedData(isolate, std::move(encoded)));
+}
+
 #if defined(OS_MAC)
 bool IsTemplateFilename(const base::FilePath& path) {
   return (base::MatchPattern(path.value(), "*Template.*") ||
@@ -213,11 +310,9 @@ v8::Local<v8::Value> NativeImage::ToPNG(gin::Arguments* args) {
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
-  std::vector<unsigned char> encoded;
-  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
-  const char* data = reinterpret_cast<char*>(encoded.data());
-  size_t size = encoded.size();
-  return node::Buffer::Copy(args->isolate(), data, size).ToLocalChecked();
+  auto encoded = std::make_unique<std::vector<unsigned char>>();
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, encoded.get());
+  return AdoptEncodedData(args->isolate(), std::move(encoded));
 }
 
 v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
@@ -242,14 +337,70 @@ v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
-  std::vector<unsigned char> output;
-  gfx::JPEG1xEncodedDataFromImage(image_, quality, &output);
-  if (output.empty())
-    return node::Buffer::New(isolate, 0).ToLocalChecked();
-  return node::Buffer::Copy(isolate,
-                            reinterpret_cast<const char*>(&output.front()),
-                            output.size())
-      .ToLocalChecked();
+  auto output = std::make_unique<std::vector<unsigned char>>();
+  gfx::JPEG1xEncodedDataFromImage(image_, quality, output.get());
+  return AdoptEncodedData(isolate, std::move(output));
+}
+
+v8::Local<v8::Promise> NativeImage::Encode(gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  EncodeOptions options;
+  float scale_factor = 1.0f;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::string format;
+    if (dict.Get("format", &format)) {
+      if (format == "png") {
+        options.format = ImageFormat::kPNG;
+      } else if (format == "jpeg") {
+        options.format = ImageFormat::kJPEG;
+      } else if (format == "webp") {
+        options.format = ImageFormat::kWebP;
+      } else {
+        promise.RejectWithErrorMessage("Unsupported image format: " + format);
+        return handle;
+      }
+    }
+    if (dict.Get("quality", &options.quality) &&
+        (options.quality < 0 || options.quality > 100)) {
+      promise.RejectWithErrorMessage("quality must be between 0 and 100");
+      return handle;
+    }
+    dict.Get("lossless", &options.lossless);
+    dict.Get("fast", &options.fast);
+    dict.Get("scaleFactor", &scale_factor);
+  }
+
+  if (IsEmpty()) {
+    promise.Resolve(node::Buffer::New(args->isolate(), 0).ToLocalChecked());
+    return handle;
+  }
+
+  if (options.format == ImageFormat::kPNG && !options.fast &&
+      scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      // Copied, the image keeps using these bytes.
+      const char* data = reinterpret_cast<const char*>(png->front());
+      promise.Resolve(node::Buffer::Copy(args->isolate(), data, png->size())
+                          .ToLocalChecked());
+      return handle;
+    }
+  }
+
+  // The bitmap shares its pixels with the image, no copy is made here.
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&EncodeBitmap, bitmap, options),
+      base::BindOnce(&OnBitmapEncoded, std::move(promise)));
+  return handle;
 }
 
 std::string NativeImage::ToDataURL(gin::Arguments* args) {
@@ -589,6 +740,7 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
                                     constructor->InstanceTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("encode", &NativeImage::Encode)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getScaleFactors", &NativeImage::GetScaleFactors)
@@ -2,9 +2,12 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/hash/hash.h"
+#include "base/strings/string_util.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_api_key_weak_map.h"
 #include "shell/common/gin_converters/content_converter.h"
@@ -141,6 +144,20 @@ void TriggerFatalErrorForTesting(v8::Isolate* isolate) {
 void RunUntilIdle() {
   base::RunLoop().RunUntilIdle();
 }
+
+// Sets each of |names| on a new object through one reused key buffer, which
+// must not be mistaken for a string literal by the property name cache.
+v8::Local<v8::Object> SetPropertiesFromBufferForTesting(
+    v8::Isolate* isolate,
+    const std::vector<std::string>& names) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  char key[64];
+  for (size_t i = 0; i < names.size(); ++i) {
+    base::strlcpy(key, names[i].c_str(), sizeof(key));
+    dict.Set(key, static_cast<int>(i));
+  }
+  return dict.GetHandle();
+}
 #endif
 
 void Initialize(v8::Local<v8::Object> exports,
@@ -162,6 +179,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("clearWeaklyTrackedValues", &ClearWeaklyTrackedValues);
   dict.SetMethod("weaklyTrackValue", &WeaklyTrackValue);
   dict.SetMethod("runUntilIdle", &RunUntilIdle);
+  dict.SetMethod("setPropertiesFromBufferForTesting",
+                 &SetPropertiesFromBufferForTesting);
 #endif
 }
 
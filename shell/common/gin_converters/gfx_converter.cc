@@ -4,9 +4,11 @@
 
 #include "shell/common/gin_converters/gfx_converter.h"
 
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "ui/display/display.h"
 #include "ui/display/screen.h"
+#include "ui/gfx/color_space.h"
 #include "ui/gfx/geometry/point.h"
 #include "ui/gfx/geometry/point_f.h"
 #include "ui/gfx/geometry/rect.h"
@@ -186,4 +188,84 @@ v8::Local<v8::Value> Converter<gfx::ResizeEdge>::ToV8(
   }
 }
 
+// Uses the names of the VideoColorSpace members from WebCodecs, values that
+// have no name there are reported as null.
+v8::Local<v8::Value> Converter<gfx::ColorSpace>::ToV8(
+    v8::Isolate* isolate,
+    const gfx::ColorSpace& val) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  switch (val.GetPrimaryID()) {
+    case gfx::ColorSpace::PrimaryID::BT709:
+      dict.Set("primaries", "bt709");
+      break;
+    case gfx::ColorSpace::PrimaryID::BT470BG:
+      dict.Set("primaries", "bt470bg");
+      break;
+    case gfx::ColorSpace::PrimaryID::SMPTE170M:
+      dict.Set("primaries", "smpte170m");
+      break;
+    case gfx::ColorSpace::PrimaryID::BT2020:
+      dict.Set("primaries", "bt2020");
+      break;
+    default:
+      dict.Set("primaries", nullptr);
+      break;
+  }
+  switch (val.GetTransferID()) {
+    case gfx::ColorSpace::TransferID::BT709:
+      dict.Set("transfer", "bt709");
+      break;
+    case gfx::ColorSpace::TransferID::SMPTE170M:
+      dict.Set("transfer", "smpte170m");
+      break;
+    case gfx::ColorSpace::TransferID::IEC61966_2_1:
+      dict.Set("transfer", "iec61966-2-1");
+      break;
+    case gfx::ColorSpace::TransferID::LINEAR:
+      dict.Set("transfer", "linear");
+      break;
+    case gfx::ColorSpace::TransferID::SMPTEST2084:
+      dict.Set("transfer", "pq");
+      break;
+    case gfx::ColorSpace::TransferID::ARIB_STD_B67:
+      dict.Set("transfer", "hlg");
+      break;
+    default:
+      dict.Set("transfer", nullptr);
+      break;
+  }
+  switch (val.GetMatrixID()) {
+    case gfx::ColorSpace::MatrixID::RGB:
+      dict.Set("matrix", "rgb");
+      break;
+    case gfx::ColorSpace::MatrixID::BT709:
+      dict.Set("matrix", "bt709");
+      break;
+    case gfx::ColorSpace::MatrixID::BT470BG:
+      dict.Set("matrix", "bt470bg");
+      break;
+    case gfx::ColorSpace::MatrixID::SMPTE170M:
+      dict.Set("matrix", "smpte170m");
+      break;
+    case gfx::ColorSpace::MatrixID::BT2020_NCL:
+      dict.Set("matrix", "bt2020-ncl");
+      break;
+    default:
+      dict.Set("matrix", nullptr);
+      break;
+  }
+  switch (val.GetRangeID()) {
+    case gfx::ColorSpace::RangeID::FULL:
+      dict.Set("fullRange", true);
+      break;
+    case gfx::ColorSpace::RangeID::LIMITED:
+      dict.Set("fullRange", false);
+      break;
+    default:
+      dict.Set("fullRange", nullptr);
+      break;
+  }
+  return dict.GetHandle();
+}
+
 }  // namespace gin
@@ -12,6 +12,7 @@ class Display;
 }
 
 namespace gfx {
+class ColorSpace;
 class Point;
 class PointF;
 class Size;
@@ -69,6 +70,12 @@ struct Converter<gfx::ResizeEdge> {
                                    const gfx::ResizeEdge& val);
 };
 
+template <>
+struct Converter<gfx::ColorSpace> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const gfx::ColorSpace& val);
+};
+
 }  // namespace gin
 
 #endif  // SHELL_COMMON_GIN_CONVERTERS_GFX_CONVERTER_H_
@@ -11,6 +11,7 @@
 #include "gin/dictionary.h"
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/function_template.h"
+#include "shell/common/gin_helper/property_name_cache.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace gin_helper {
@@ -33,13 +34,15 @@ class Dictionary : public gin::Dictionary {
   // Differences from the Get method in gin::Dictionary:
   // 1. This is a const method;
   // 2. It checks whether the key exists before reading;
-  // 3. It accepts arbitrary type of key.
+  // 3. It accepts arbitrary type of key, string literal keys are looked up in
+  //    the per-isolate property name cache.
   template <typename K, typename V>
-  bool Get(const K& key, V* out) const {
+  bool Get(K&& key, V* out) const {
     // Check for existence before getting, otherwise this method will always
     // returns true when T == v8::Local<v8::Value>.
     v8::Local<v8::Context> context = isolate()->GetCurrentContext();
-    v8::Local<v8::Value> v8_key = gin::ConvertToV8(isolate(), key);
+    v8::Local<v8::Value> v8_key =
+        internal::PropertyKeyToV8(isolate(), std::forward<K>(key));
     v8::Local<v8::Value> value;
     v8::Maybe<bool> result = GetHandle()->Has(context, v8_key);
     if (result.IsJust() && result.FromJust() &&
@@ -49,15 +52,16 @@ class Dictionary : public gin::Dictionary {
   }
 
   // Differences from the Set method in gin::Dictionary:
-  // 1. It accepts arbitrary type of key.
+  // 1. It accepts arbitrary type of key, string literal keys are looked up in
+  //    the per-isolate property name cache.
   template <typename K, typename V>
-  bool Set(const K& key, const V& val) {
+  bool Set(K&& key, const V& val) {
     v8::Local<v8::Value> v8_value;
     if (!gin::TryConvertToV8(isolate(), val, &v8_value))
       return false;
-    v8::Maybe<bool> result =
-        GetHandle()->Set(isolate()->GetCurrentContext(),
-                         gin::ConvertToV8(isolate(), key), v8_value);
+    v8::Maybe<bool> result = GetHandle()->Set(
+        isolate()->GetCurrentContext(),
+        internal::PropertyKeyToV8(isolate(), std::forward<K>(key)), v8_value);
     return !result.IsNothing() && result.FromJust();
   }
 
@@ -6,9 +6,12 @@
 
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
+#include "gin/per_isolate_data.h"
+#include "gin/public/wrapper_info.h"
 #include "shell/browser/api/event.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/property_name_cache.h"
 
 namespace gin_helper {
 
@@ -16,12 +19,52 @@ namespace internal {
 
 namespace {
 
-v8::Persistent<v8::ObjectTemplate> event_template;
+// Key of the event template, which is built once per isolate and reused on
+// every emit.
+gin::WrapperInfo kEventWrapperInfo = {gin::kEmbedderNativeGin};
+
+// Index of the internal field holding the defaultPrevented flag.
+constexpr int kDefaultPreventedField = 0;
 
 void PreventDefault(gin_helper::Arguments* args) {
-  Dictionary self;
+  v8::Local<v8::Object> self;
   if (args->GetHolder(&self))
-    self.Set("defaultPrevented", true);
+    self->SetInternalField(kDefaultPreventedField, v8::True(args->isolate()));
+}
+
+void DefaultPreventedGetter(v8::Local<v8::Name> property,
+                            const v8::PropertyCallbackInfo<v8::Value>& info) {
+  info.GetReturnValue().Set(
+      info.Holder()->GetInternalField(kDefaultPreventedField));
+}
+
+void DefaultPreventedSetter(v8::Local<v8::Name> property,
+                            v8::Local<v8::Value> value,
+                            const v8::PropertyCallbackInfo<void>& info) {
+  v8::Isolate* isolate = info.GetIsolate();
+  info.Holder()->SetInternalField(
+      kDefaultPreventedField,
+      v8::Boolean::New(isolate, value->BooleanValue(isolate)));
+}
+
+v8::Local<v8::ObjectTemplate> GetEventTemplate(v8::Isolate* isolate) {
+  gin::PerIsolateData* data = gin::PerIsolateData::From(isolate);
+  v8::Local<v8::ObjectTemplate> event_template =
+      data->GetObjectTemplate(&kEventWrapperInfo);
+  if (!event_template.IsEmpty())
+    return event_template;
+
+  event_template =
+      ObjectTemplateBuilder(isolate, v8::ObjectTemplate::New(isolate))
+          .SetMethod("preventDefault", &PreventDefault)
+          .Build();
+  event_template->SetInternalFieldCount(kDefaultPreventedField + 1);
+  event_template->SetAccessor(GetPropertyName(isolate, "defaultPrevented"),
+                              &DefaultPreventedGetter, &DefaultPreventedSetter,
+                              v8::Local<v8::Value>(), v8::DEFAULT,
+                              v8::DontEnum);
+  data->SetObjectTemplate(&kEventWrapperInfo, event_template);
+  return event_template;
 }
 
 }  // namespace
@@ -29,22 +72,13 @@ void PreventDefault(gin_helper::Arguments* args) {
 v8::Local<v8::Object> CreateEvent(v8::Isolate* isolate,
                                   v8::Local<v8::Object> sender,
                                   v8::Local<v8::Object> custom_event) {
-  if (event_template.IsEmpty()) {
-    event_template.Reset(
-        isolate,
-        ObjectTemplateBuilder(isolate, v8::ObjectTemplate::New(isolate))
-            .SetMethod("preventDefault", &PreventDefault)
-            .Build());
-  }
-
   v8::Local<v8::Context> context = isolate->GetCurrentContext();
   CHECK(!context.IsEmpty());
   v8::Local<v8::Object> event =
-      v8::Local<v8::ObjectTemplate>::New(isolate, event_template)
-          ->NewInstance(context)
-          .ToLocalChecked();
+      GetEventTemplate(isolate)->NewInstance(context).ToLocalChecked();
+  event->SetInternalField(kDefaultPreventedField, v8::False(isolate));
   if (!sender.IsEmpty())
-    Dictionary(isolate, event).Set("sender", sender);
+    event->Set(context, GetPropertyName(isolate, "sender"), sender).Check();
   if (!custom_event.IsEmpty())
     event->SetPrototype(context, custom_event).IsJust();
   return event;
@@ -75,6 +109,55 @@ v8::Local<v8::Object> CreateNativeEvent(
   return event;
 }
 
+bool HasListeners(v8::Isolate* isolate,
+                  v8::Local<v8::Object> emitter,
+                  v8::Local<v8::String> name) {
+  if (emitter.IsEmpty())
+    return false;
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+  // Emitting "error" without a listener throws, so it is never skipped.
+  if (name->StringEquals(GetPropertyName(isolate, "error")))
+    return true;
+
+  // Some objects override emit() to forward events elsewhere, e.g. the native
+  // powerMonitor, so only the stock EventEmitter bookkeeping is trusted.
+  if (emitter->HasOwnProperty(context, GetPropertyName(isolate, "emit"))
+          .FromMaybe(true))
+    return true;
+
+  v8::Local<v8::Value> events;
+  if (!emitter->Get(context, GetPropertyName(isolate, "_events"))
+           .ToLocal(&events))
+    return true;
+  // EventEmitter creates the _events map when the first listener is added.
+  if (events->IsUndefined())
+    return false;
+  if (!events->IsObject())
+    return true;
+
+  v8::Local<v8::Value> listeners;
+  if (!events.As<v8::Object>()->Get(context, name).ToLocal(&listeners))
+    return true;
+  return !listeners->IsUndefined();
+}
+
+bool IsDefaultPrevented(v8::Isolate* isolate, v8::Local<v8::Object> event) {
+  return event->GetInternalField(kDefaultPreventedField)
+      ->BooleanValue(isolate);
+}
+
+bool GetDefaultPrevented(v8::Isolate* isolate, v8::Local<v8::Object> event) {
+  v8::Local<v8::Value> default_prevented;
+  if (event
+          ->Get(isolate->GetCurrentContext(),
+                GetPropertyName(isolate, "defaultPrevented"))
+          .ToLocal(&default_prevented)) {
+    return default_prevented->BooleanValue(isolate);
+  }
+  return false;
+}
+
 }  // namespace internal
 
 }  // namespace gin_helper
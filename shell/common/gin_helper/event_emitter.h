@@ -31,6 +31,19 @@ v8::Local<v8::Object> CreateNativeEvent(
     content::RenderFrameHost* frame,
     electron::mojom::ElectronBrowser::MessageSyncCallback callback);
 
+// Returns whether |emitter| might have listeners for |name|. Emitting to an
+// object without any is skipped, which avoids creating the event and
+// converting the arguments.
+bool HasListeners(v8::Isolate* isolate,
+                  v8::Local<v8::Object> emitter,
+                  v8::Local<v8::String> name);
+
+// Reads the defaultPrevented flag of an event returned by CreateEvent().
+bool IsDefaultPrevented(v8::Isolate* isolate, v8::Local<v8::Object> event);
+
+// Reads event.defaultPrevented of an arbitrary event object.
+bool GetDefaultPrevented(v8::Isolate* isolate, v8::Local<v8::Object> event);
+
 }  // namespace internal
 
 // Provide helperers to emit event in JavaScript.
@@ -53,7 +66,10 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   bool EmitCustomEvent(base::StringPiece name,
                        v8::Local<v8::Object> event,
                        Args&&... args) {
-    return EmitWithEvent(name,
+    v8::Local<v8::String> event_name = gin::StringToSymbol(isolate(), name);
+    if (!internal::HasListeners(isolate(), GetWrapper(), event_name))
+      return false;
+    return EmitWithEvent(event_name,
                          internal::CreateEvent(isolate(), GetWrapper(), event),
                          std::forward<Args>(args)...);
   }
@@ -66,8 +82,11 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     v8::Local<v8::Object> wrapper = GetWrapper();
     if (wrapper.IsEmpty())
       return false;
+    v8::Local<v8::String> event_name = gin::StringToSymbol(isolate(), name);
+    if (!internal::HasListeners(isolate(), wrapper, event_name))
+      return false;
     v8::Local<v8::Object> event = internal::CreateEvent(isolate(), wrapper);
-    return EmitWithEvent(name, event, std::forward<Args>(args)...);
+    return EmitWithEvent(event_name, event, std::forward<Args>(args)...);
   }
 
  protected:
@@ -76,21 +95,15 @@ class EventEmitter : public gin_helper::Wrappable<T> {
  private:
   // this.emit(name, event, args...);
   template <typename... Args>
-  bool EmitWithEvent(base::StringPiece name,
+  bool EmitWithEvent(v8::Local<v8::String> name,
                      v8::Local<v8::Object> event,
                      Args&&... args) {
     // It's possible that |this| will be deleted by EmitEvent, so save anything
     // we need from |this| before calling EmitEvent.
     auto* isolate = this->isolate();
-    auto context = isolate->GetCurrentContext();
     gin_helper::EmitEvent(isolate, GetWrapper(), name, event,
                           std::forward<Args>(args)...);
-    v8::Local<v8::Value> defaultPrevented;
-    if (event->Get(context, gin::StringToV8(isolate, "defaultPrevented"))
-            .ToLocal(&defaultPrevented)) {
-      return defaultPrevented->BooleanValue(isolate);
-    }
-    return false;
+    return internal::IsDefaultPrevented(isolate, event);
   }
 
   DISALLOW_COPY_AND_ASSIGN(EventEmitter);
@@ -17,6 +17,19 @@ namespace internal {
 
 using ValueVector = std::vector<v8::Local<v8::Value>>;
 
+// Event names that are already V8 strings, e.g. internalized ones used to
+// look up listeners, are passed through as they are.
+inline v8::Local<v8::String> EventNameToV8(v8::Isolate* isolate,
+                                           v8::Local<v8::String> name) {
+  return name;
+}
+
+template <typename StringType>
+v8::Local<v8::String> EventNameToV8(v8::Isolate* isolate,
+                                    const StringType& name) {
+  return gin::StringToV8(isolate, name);
+}
+
 v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
                                         v8::Local<v8::Object> obj,
                                         const char* method,
@@ -31,7 +44,8 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                v8::Local<v8::Object> obj,
                                const StringType& name,
                                const internal::ValueVector& args) {
-  internal::ValueVector concatenated_args = {gin::StringToV8(isolate, name)};
+  internal::ValueVector concatenated_args = {
+      internal::EventNameToV8(isolate, name)};
   concatenated_args.reserve(1 + args.size());
   concatenated_args.insert(concatenated_args.end(), args.begin(), args.end());
   return internal::CallMethodWithArgs(isolate, obj, "emit", &concatenated_args);
@@ -45,7 +59,7 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                const StringType& name,
                                Args&&... args) {
   internal::ValueVector converted_args = {
-      gin::StringToV8(isolate, name),
+      internal::EventNameToV8(isolate, name),
       gin::ConvertToV8(isolate, std::forward<Args>(args))...,
   };
   return internal::CallMethodWithArgs(isolate, obj, "emit", &converted_args);
@@ -0,0 +1,63 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/gin_helper/property_name_cache.h"
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local.h"
+#include "gin/converter.h"
+
+namespace gin_helper {
+
+namespace {
+
+struct CachedName {
+  // The contents |name| had when it was cached, since an address may be
+  // reused for a different string.
+  std::string name;
+  v8::Eternal<v8::String> value;
+};
+
+// Isolates are only ever used from one thread at a time in Electron, and each
+// thread runs at most one of them, so the names are cached per thread and
+// dropped if a different isolate shows up.
+struct PropertyNameCache {
+  v8::Isolate* isolate = nullptr;
+  base::flat_map<const char*, CachedName> names;
+};
+
+PropertyNameCache* GetCache(v8::Isolate* isolate) {
+  static base::NoDestructor<base::ThreadLocalOwnedPointer<PropertyNameCache>>
+      tls;
+  PropertyNameCache* cache = tls->Get();
+  if (!cache) {
+    tls->Set(std::make_unique<PropertyNameCache>());
+    cache = tls->Get();
+  }
+  if (cache->isolate != isolate) {
+    cache->isolate = isolate;
+    cache->names.clear();
+  }
+  return cache;
+}
+
+}  // namespace
+
+v8::Local<v8::String> GetPropertyName(v8::Isolate* isolate, const char* name) {
+  CachedName& cached = GetCache(isolate)->names[name];
+  if (!cached.value.IsEmpty() && cached.name == name)
+    return cached.value.Get(isolate);
+
+  // A stale entry keeps its eternal handle alive, which only happens for the
+  // rare arrays whose storage is reused.
+  v8::Local<v8::String> result = gin::StringToSymbol(isolate, name);
+  cached.name = name;
+  cached.value.Set(isolate, result);
+  return result;
+}
+
+}  // namespace gin_helper
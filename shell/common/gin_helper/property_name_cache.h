@@ -0,0 +1,45 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_GIN_HELPER_PROPERTY_NAME_CACHE_H_
+#define SHELL_COMMON_GIN_HELPER_PROPERTY_NAME_CACHE_H_
+
+#include <cstddef>
+
+#include "gin/converter.h"
+#include "v8/include/v8.h"
+
+namespace gin_helper {
+
+// Returns the internalized string for |name|, creating it only the first time
+// it is requested for the isolate. Entries are keyed by the address of |name|
+// and their contents are checked on every hit, so arrays whose storage is
+// reused for other strings get a fresh string instead of a stale one.
+v8::Local<v8::String> GetPropertyName(v8::Isolate* isolate, const char* name);
+
+namespace internal {
+
+// Converts a property key to V8, looking string literals up in the cache.
+template <typename K>
+v8::Local<v8::Value> PropertyKeyToV8(v8::Isolate* isolate, const K& key) {
+  return gin::ConvertToV8(isolate, key);
+}
+
+template <size_t N>
+v8::Local<v8::Value> PropertyKeyToV8(v8::Isolate* isolate,
+                                     const char (&key)[N]) {
+  return GetPropertyName(isolate, key);
+}
+
+// Mutable buffers may change their contents, so they are never cached.
+template <size_t N>
+v8::Local<v8::Value> PropertyKeyToV8(v8::Isolate* isolate, char (&key)[N]) {
+  return gin::StringToV8(isolate, key);
+}
+
+}  // namespace internal
+
+}  // namespace gin_helper
+
+#endif  // SHELL_COMMON_GIN_HELPER_PROPERTY_NAME_CACHE_H_
@@ -302,17 +302,20 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
+  // Loops on the shared poller are detached from it by the derived class.
+  if (!uses_shared_poller_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
 
-  WakeupEmbedThread();
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
 
-  // Clear uv.
-  uv_sem_destroy(&embed_sem_);
+    // Clear uv.
+    uv_sem_destroy(&embed_sem_);
+  }
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -537,6 +540,13 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  // Workers don't get a polling thread each when the platform can watch all
+  // of their loops from one thread.
+  if (browser_env_ == BrowserEnvironment::kWorker && AttachSharedPoller()) {
+    uses_shared_poller_ = true;
+    return;
+  }
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -589,7 +599,10 @@ void NodeBindings::UvRunOnce() {
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (uses_shared_poller_)
+    ResumeSharedPoller();
+  else
+    uv_sem_post(&embed_sem_);
 }
 
 void NodeBindings::WakeupMainThread() {
@@ -602,6 +615,12 @@ void NodeBindings::WakeupEmbedThread() {
   uv_async_send(dummy_uv_handle_.get());
 }
 
+bool NodeBindings::AttachSharedPoller() {
+  return false;
+}
+
+void NodeBindings::ResumeSharedPoller() {}
+
 // static
 void NodeBindings::EmbedThreadRunner(void* arg) {
   auto* self = static_cast<NodeBindings*>(arg);
@@ -125,6 +125,17 @@ class NodeBindings {
   // Interrupt the PollEvents.
   void WakeupEmbedThread();
 
+  // Platforms that can multiplex several uv loops on one thread override
+  // these so that worker loops share a single poller instead of each
+  // starting their own embed thread. AttachSharedPoller() returns false when
+  // the loop should fall back to an embed thread.
+  virtual bool AttachSharedPoller();
+  // Called on the loop's thread after each run of the uv loop, asks the shared
+  // poller to wake us up on the next uv event.
+  virtual void ResumeSharedPoller();
+
+  bool uses_shared_poller() const { return uses_shared_poller_; }
+
   // Which environment we are running.
   const BrowserEnvironment browser_env_;
 
@@ -141,6 +152,10 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether the uv loop is polled by the shared poller instead of
+  // |embed_thread_|.
+  bool uses_shared_poller_ = false;
+
   // Loop used when constructed in WORKER mode
   uv_loop_t worker_loop_;
 
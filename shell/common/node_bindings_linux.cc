@@ -5,9 +5,160 @@
 #include "shell/common/node_bindings_linux.h"
 
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
 
 namespace electron {
 
+namespace {
+
+// Polls the backend fds of every worker's uv loop from a single thread, so
+// that a page with many Node-enabled workers doesn't need one polling thread
+// per worker. Each loop is armed for one wakeup at a time: once its fd
+// becomes readable or its uv timeout expires the loop's thread is told to
+// run it, and it re-arms itself after that run.
+class WorkerPoller {
+ public:
+  static WorkerPoller* Get() {
+    static base::NoDestructor<WorkerPoller> poller;
+    return poller.get();
+  }
+
+  WorkerPoller() : epoll_(epoll_create1(EPOLL_CLOEXEC)) {
+    wakeup_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wakeup_fd_, &ev);
+    uv_thread_create(&thread_, ThreadRunner, this);
+  }
+
+  // Arms |key|'s loop: |wakeup| runs on the poller thread once |fd| becomes
+  // readable or |timeout| milliseconds have passed (-1 for no timeout).
+  void Watch(const void* key,
+             int fd,
+             int timeout,
+             base::RepeatingClosure wakeup) {
+    base::AutoLock lock(lock_);
+    auto& watch = watches_[key];
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = const_cast<void*>(key);
+    int op = watch.fd == -1 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+    watch.fd = fd;
+    watch.wakeup = std::move(wakeup);
+    watch.armed = true;
+    epoll_ctl(epoll_, op, fd, &ev);
+
+    // A new deadline may be earlier than the one the poller is sleeping on.
+    if (timeout >= 0) {
+      watch.deadline =
+          base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(timeout);
+      uint64_t one = 1;
+      ignore_result(write(wakeup_fd_, &one, sizeof(one)));
+    } else {
+      watch.deadline = base::TimeTicks::Max();
+    }
+  }
+
+  // After this returns |key|'s wakeup callback is never run again.
+  void Unwatch(const void* key) {
+    base::AutoLock lock(lock_);
+    auto it = watches_.find(key);
+    if (it == watches_.end())
+      return;
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    watches_.erase(it);
+  }
+
+ private:
+  struct Entry {
+    int fd = -1;
+    bool armed = false;
+    base::TimeTicks deadline = base::TimeTicks::Max();
+    base::RepeatingClosure wakeup;
+  };
+
+  static void ThreadRunner(void* arg) {
+    static_cast<WorkerPoller*>(arg)->Run();
+  }
+
+  void Run() {
+    struct epoll_event events[16];
+    while (true) {
+      int timeout = ComputeTimeout();
+
+      int r;
+      do {
+        r = epoll_wait(epoll_, events, base::size(events), timeout);
+      } while (r == -1 && errno == EINTR);
+
+      // The lock is held while running wakeups so that Unwatch() can not
+      // return while a loop's callback is in progress.
+      base::AutoLock lock(lock_);
+      for (int i = 0; i < r; ++i) {
+        if (!events[i].data.ptr) {
+          uint64_t value;
+          ignore_result(read(wakeup_fd_, &value, sizeof(value)));
+          continue;
+        }
+        auto it = watches_.find(events[i].data.ptr);
+        if (it != watches_.end())
+          Fire(&it->second);
+      }
+      base::TimeTicks now = base::TimeTicks::Now();
+      for (auto& it : watches_) {
+        if (it.second.armed && it.second.deadline <= now)
+          Fire(&it.second);
+      }
+    }
+  }
+
+  int ComputeTimeout() {
+    base::AutoLock lock(lock_);
+    base::TimeTicks deadline = base::TimeTicks::Max();
+    for (const auto& it : watches_) {
+      if (it.second.armed)
+        deadline = std::min(deadline, it.second.deadline);
+    }
+    if (deadline.is_max())
+      return -1;
+    // Round up so we don't wake up just before the uv timer is due.
+    return std::max<int64_t>(
+        0, (deadline - base::TimeTicks::Now()).InMillisecondsRoundedUp());
+  }
+
+  void Fire(Entry* watch) {
+    if (!watch->armed)
+      return;
+    watch->armed = false;
+    watch->deadline = base::TimeTicks::Max();
+    watch->wakeup.Run();
+  }
+
+  int epoll_;
+  int wakeup_fd_;
+  uv_thread_t thread_;
+
+  base::Lock lock_;
+  std::map<const void*, Entry> watches_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerPoller);
+};
+
+}  // namespace
+
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
     : NodeBindings(browser_env), epoll_(epoll_create(1)) {
   int backend_fd = uv_backend_fd(uv_loop_);
@@ -17,7 +168,10 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
 }
 
-NodeBindingsLinux::~NodeBindingsLinux() = default;
+NodeBindingsLinux::~NodeBindingsLinux() {
+  if (uses_shared_poller())
+    WorkerPoller::Get()->Unwatch(this);
+}
 
 void NodeBindingsLinux::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
@@ -47,6 +201,19 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::AttachSharedPoller() {
+  // The loop is armed after its first run, see ResumeSharedPoller().
+  return true;
+}
+
+void NodeBindingsLinux::ResumeSharedPoller() {
+  // The loop is idle on this thread, so its timeout can be read here.
+  WorkerPoller::Get()->Watch(
+      this, uv_backend_fd(uv_loop_), uv_backend_timeout(uv_loop_),
+      base::BindRepeating(&NodeBindingsLinux::WakeupMainThread,
+                          base::Unretained(this)));
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
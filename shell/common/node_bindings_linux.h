@@ -22,6 +22,8 @@ class NodeBindingsLinux : public NodeBindings {
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
+  bool AttachSharedPoller() override;
+  void ResumeSharedPoller() override;
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
@@ -161,6 +161,9 @@ const char kOffscreen[] = "offscreen";
 
 const char kNodeIntegrationInSubFrames[] = "nodeIntegrationInSubFrames";
 
+// Defer creating the Node environment until the page uses it.
+const char kLazyNodeEnvironment[] = "lazyNodeEnvironment";
+
 // Disable window resizing when HTML Fullscreen API is activated.
 const char kDisableHtmlFullscreenWindowResize[] =
     "disableHtmlFullscreenWindowResize";
@@ -14,40 +14,74 @@ namespace api {
 
 namespace context_bridge {
 
+namespace {
+
+// Most bridge calls only ever see a handful of objects, start small enough
+// that constructing a cache per call stays cheap.
+constexpr size_t kInitialCapacity = 16;
+
+// Identity hashes are random but not uniformly distributed in the low bits,
+// scramble them before masking.
+inline size_t MixHash(int hash) {
+  return static_cast<size_t>(static_cast<uint32_t>(hash) * 0x9E3779B1u);
+}
+
+}  // namespace
+
 ObjectCache::ObjectCache() = default;
 ObjectCache::~ObjectCache() = default;
 
+size_t ObjectCache::FindSlot(int hash, v8::Local<v8::Value> from) const {
+  const size_t mask = slots_.size() - 1;
+  size_t index = MixHash(hash) & mask;
+  while (true) {
+    const Entry& entry = slots_[index];
+    if (entry.from.IsEmpty() || (entry.hash == hash && entry.from == from))
+      return index;
+    index = (index + 1) & mask;
+  }
+}
+
+void ObjectCache::Grow() {
+  std::vector<Entry> old_slots = std::move(slots_);
+  slots_.clear();
+  slots_.resize(old_slots.empty() ? kInitialCapacity : old_slots.size() * 2);
+  for (const auto& entry : old_slots) {
+    if (!entry.from.IsEmpty())
+      slots_[FindSlot(entry.hash, entry.from)] = entry;
+  }
+}
+
 void ObjectCache::CacheProxiedObject(v8::Local<v8::Value> from,
                                      v8::Local<v8::Value> proxy_value) {
   if (from->IsObject() && !from->IsNullOrUndefined()) {
     auto obj = from.As<v8::Object>();
     int hash = obj->GetIdentityHash();
 
-    proxy_map_[hash].push_front(std::make_pair(from, proxy_value));
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    if ((size_ + 1) * 2 > slots_.size())
+      Grow();
+
+    Entry& entry = slots_[FindSlot(hash, from)];
+    if (entry.from.IsEmpty()) {
+      entry.hash = hash;
+      entry.from = from;
+      ++size_;
+    }
+    entry.proxy = proxy_value;
   }
 }
 
 v8::MaybeLocal<v8::Value> ObjectCache::GetCachedProxiedObject(
     v8::Local<v8::Value> from) const {
-  if (!from->IsObject() || from->IsNullOrUndefined())
+  if (!from->IsObject() || from->IsNullOrUndefined() || size_ == 0)
     return v8::MaybeLocal<v8::Value>();
 
   auto obj = from.As<v8::Object>();
-  int hash = obj->GetIdentityHash();
-  auto iter = proxy_map_.find(hash);
-  if (iter == proxy_map_.end())
+  const Entry& entry = slots_[FindSlot(obj->GetIdentityHash(), from)];
+  if (entry.from.IsEmpty() || entry.proxy.IsEmpty())
     return v8::MaybeLocal<v8::Value>();
-
-  auto& list = iter->second;
-  for (const auto& pair : list) {
-    auto from_cmp = pair.first;
-    if (from_cmp == from) {
-      if (pair.second.IsEmpty())
-        return v8::MaybeLocal<v8::Value>();
-      return pair.second;
-    }
-  }
-  return v8::MaybeLocal<v8::Value>();
+  return entry.proxy;
 }
 
 }  // namespace context_bridge
@@ -5,10 +5,9 @@
 #ifndef SHELL_RENDERER_API_CONTEXT_BRIDGE_OBJECT_CACHE_H_
 #define SHELL_RENDERER_API_CONTEXT_BRIDGE_OBJECT_CACHE_H_
 
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
-#include "base/containers/linked_list.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
@@ -20,8 +19,13 @@ namespace api {
 
 namespace context_bridge {
 
-using ObjectCachePair = std::pair<v8::Local<v8::Value>, v8::Local<v8::Value>>;
-
+// Identity map from a value in the source context to the value that was
+// created for it in the destination context.  This is an open-addressing
+// table keyed on the V8 identity hash so that lookups for large shared or
+// cyclic structures stay O(1) instead of walking per-hash collision lists.
+//
+// The handles stored here are plain v8::Locals, so an ObjectCache must never
+// outlive the HandleScope that was active while it was populated.
 class ObjectCache final {
  public:
   ObjectCache();
@@ -33,8 +37,20 @@ class ObjectCache final {
       v8::Local<v8::Value> from) const;
 
  private:
-  // object_identity ==> [from_value, proxy_value]
-  std::unordered_map<int, std::forward_list<ObjectCachePair>> proxy_map_;
+  struct Entry {
+    int hash = 0;
+    v8::Local<v8::Value> from;
+    v8::Local<v8::Value> proxy;
+  };
+
+  // Returns the slot holding |from|, or the empty slot where it would be
+  // inserted.  |slots_| must be non-empty.
+  size_t FindSlot(int hash, v8::Local<v8::Value> from) const;
+  void Grow();
+
+  // Power-of-two sized so that probing can mask instead of dividing.
+  std::vector<Entry> slots_;
+  size_t size_ = 0;
 };
 
 }  // namespace context_bridge
@@ -20,6 +20,7 @@
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/world_ids.h"
@@ -46,6 +47,8 @@ const char* const kSupportsDynamicPropertiesPrivateKey =
     "electron_contextBridge_supportsDynamicProperties";
 const char* const kOriginalFunctionPrivateKey =
     "electron_contextBridge_original_fn";
+const char* const kTransferArrayBufferPrivateKey =
+    "electron_contextBridge_transfer";
 
 }  // namespace context_bridge
 
@@ -131,6 +134,80 @@ v8::MaybeLocal<v8::Value> GetPrivate(v8::Local<v8::Context> context,
                           gin::StringToV8(context->GetIsolate(), key)));
 }
 
+// Returns the ArrayBuffer that |value| owns or views in its entirety, views
+// over only part of a buffer (e.g. pooled Node Buffers) can't be transferred
+// without taking the rest of the buffer with them.
+bool GetTransferableArrayBuffer(v8::Local<v8::Value> value,
+                                v8::Local<v8::ArrayBuffer>* buffer) {
+  if (value->IsArrayBuffer()) {
+    *buffer = value.As<v8::ArrayBuffer>();
+  } else if (value->IsArrayBufferView()) {
+    auto view = value.As<v8::ArrayBufferView>();
+    *buffer = view->Buffer();
+    if (view->ByteOffset() != 0 ||
+        view->ByteLength() != (*buffer)->ByteLength())
+      return false;
+  } else {
+    return false;
+  }
+  return (*buffer)->IsDetachable();
+}
+
+// Moves the backing store of an ArrayBuffer (or a view over one) that was
+// marked with contextBridge.transfer() into a new ArrayBuffer created in
+// |destination_context|.  Both worlds live in the same isolate so the bytes
+// themselves never move, the source buffer is detached so only one world
+// can observe them afterwards.
+v8::MaybeLocal<v8::Value> TransferArrayBufferToOtherContext(
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context,
+    v8::Local<v8::Value> value) {
+  v8::Local<v8::ArrayBuffer> buffer;
+  if (!GetTransferableArrayBuffer(value, &buffer))
+    return v8::MaybeLocal<v8::Value>();
+
+  v8::Local<v8::Value> marked;
+  if (!GetPrivate(source_context, buffer,
+                  context_bridge::kTransferArrayBufferPrivateKey)
+           .ToLocal(&marked) ||
+      !marked->IsTrue())
+    return v8::MaybeLocal<v8::Value>();
+
+  // Views report a length of zero once detached, grab it up front.
+  size_t length = value->IsTypedArray() ? value.As<v8::TypedArray>()->Length()
+                                        : buffer->ByteLength();
+  std::shared_ptr<v8::BackingStore> backing_store = buffer->GetBackingStore();
+  buffer->Detach();
+
+  v8::Context::Scope destination_scope(destination_context);
+  v8::Local<v8::ArrayBuffer> transferred =
+      v8::ArrayBuffer::New(destination_context->GetIsolate(), backing_store);
+  if (value->IsArrayBuffer())
+    return v8::MaybeLocal<v8::Value>(transferred);
+
+  if (value->IsDataView())
+    return v8::MaybeLocal<v8::Value>(v8::DataView::New(transferred, 0, length));
+
+#define TRANSFER_TYPED_ARRAY(Type) \
+  if (value->Is##Type())           \
+    return v8::MaybeLocal<v8::Value>(v8::Type::New(transferred, 0, length));
+  TRANSFER_TYPED_ARRAY(Uint8Array)
+  TRANSFER_TYPED_ARRAY(Uint8ClampedArray)
+  TRANSFER_TYPED_ARRAY(Int8Array)
+  TRANSFER_TYPED_ARRAY(Uint16Array)
+  TRANSFER_TYPED_ARRAY(Int16Array)
+  TRANSFER_TYPED_ARRAY(Uint32Array)
+  TRANSFER_TYPED_ARRAY(Int32Array)
+  TRANSFER_TYPED_ARRAY(Float32Array)
+  TRANSFER_TYPED_ARRAY(Float64Array)
+  TRANSFER_TYPED_ARRAY(BigInt64Array)
+  TRANSFER_TYPED_ARRAY(BigUint64Array)
+#undef TRANSFER_TYPED_ARRAY
+
+  NOTREACHED();
+  return v8::MaybeLocal<v8::Value>();
+}
+
 }  // namespace
 
 v8::MaybeLocal<v8::Value> PassValueToOtherContext(
@@ -365,6 +442,18 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
     return v8::MaybeLocal<v8::Value>(passed_value.ToLocalChecked());
   }
 
+  // ArrayBuffers explicitly marked for transfer share their backing store
+  // with the other context instead of being serialized
+  if (value->IsArrayBuffer() || value->IsArrayBufferView()) {
+    v8::Local<v8::Value> transferred;
+    if (TransferArrayBufferToOtherContext(source_context, destination_context,
+                                          value)
+            .ToLocal(&transferred)) {
+      object_cache->CacheProxiedObject(value, transferred);
+      return v8::MaybeLocal<v8::Value>(transferred);
+    }
+  }
+
   // Serializable objects
   blink::CloneableMessage ret;
   {
@@ -695,6 +784,20 @@ bool OverrideGlobalPropertyFromIsolatedWorld(
   }
 }
 
+v8::Local<v8::Value> MarkArrayBufferForTransfer(v8::Isolate* isolate,
+                                                v8::Local<v8::Value> value) {
+  v8::Local<v8::ArrayBuffer> buffer;
+  if (!GetTransferableArrayBuffer(value, &buffer)) {
+    gin_helper::ErrorThrower(isolate).ThrowTypeError(
+        "contextBridge.transfer() requires an ArrayBuffer or a view that "
+        "spans its entire detachable ArrayBuffer");
+    return v8::Undefined(isolate);
+  }
+  SetPrivate(isolate->GetCurrentContext(), buffer,
+             context_bridge::kTransferArrayBufferPrivateKey, v8::True(isolate));
+  return value;
+}
+
 bool IsCalledFromMainWorld(v8::Isolate* isolate) {
   auto* render_frame = GetRenderFrame(isolate->GetCurrentContext()->Global());
   CHECK(render_frame);
@@ -721,6 +824,8 @@ void Initialize(v8::Local<v8::Object> exports,
                  &electron::api::OverrideGlobalValueFromIsolatedWorld);
   dict.SetMethod("_overrideGlobalPropertyFromIsolatedWorld",
                  &electron::api::OverrideGlobalPropertyFromIsolatedWorld);
+  dict.SetMethod("markArrayBufferForTransfer",
+                 &electron::api::MarkArrayBufferForTransfer);
   dict.SetMethod("_isCalledFromMainWorld",
                  &electron::api::IsCalledFromMainWorld);
 #ifdef DCHECK_IS_ON
@@ -12,7 +12,9 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "components/spellcheck/renderer/spellcheck_worditerator.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template.h"
@@ -46,39 +48,174 @@ struct Word {
   std::vector<std::u16string> contraction_words;
 };
 
+// Texts of at least this many characters are tokenized on a worker thread.
+constexpr size_t kBackgroundTokenizeThreshold = 32 * 1024;
+
+// The tokenizer checks for cancellation after this many words.
+constexpr size_t kCancellationCheckInterval = 1024;
+
+// The number of words whose spelling is remembered.
+constexpr size_t kWordCacheSize = 64 * 1024;
+
 }  // namespace
 
+struct SpellCheckClient::TokenizedText {
+  std::vector<Word> word_list;  // List of Words found in text
+  std::set<std::u16string> words;
+};
+
+// Represents word iterators used in this spellchecker. The |text_iterator_|
+// splits text provided by WebKit into words, contractions, or concatenated
+// words. The |contraction_iterator_| splits a concatenated word extracted by
+// |text_iterator_| into word components so we can treat a concatenated word
+// consisting only of correct words as a correct word.
+class SpellCheckClient::WordTokenizer {
+ public:
+  explicit WordTokenizer(const std::string& language) {
+    // Represents character attributes used for filtering out characters which
+    // are not supported by this SpellCheck object.
+    character_attributes_.SetDefaultLanguage(language);
+  }
+  WordTokenizer(const WordTokenizer&) = delete;
+  WordTokenizer& operator=(const WordTokenizer&) = delete;
+  ~WordTokenizer() = default;
+
+  // Returns null if the iterators could not be initialized or |cancelled|
+  // got set while tokenizing.
+  std::unique_ptr<TokenizedText> Tokenize(const std::u16string& text,
+                                          const base::AtomicFlag* cancelled) {
+    if (!text_iterator_.IsInitialized() &&
+        !text_iterator_.Initialize(&character_attributes_, true)) {
+      VLOG(1) << "Failed to initialize SpellcheckWordIterator";
+      return nullptr;
+    }
+
+    if (!contraction_iterator_.IsInitialized() &&
+        !contraction_iterator_.Initialize(&character_attributes_, false)) {
+      VLOG(1) << "Failed to initialize contraction_iterator_";
+      return nullptr;
+    }
+
+    text_iterator_.SetText(text.c_str(), text.size());
+
+    auto tokenized = std::make_unique<TokenizedText>();
+    std::u16string word;
+    size_t word_start;
+    size_t word_length;
+    Word word_entry;
+    for (;;) {  // Run until end of text
+      if (cancelled &&
+          tokenized->word_list.size() % kCancellationCheckInterval == 0 &&
+          cancelled->IsSet())
+        return nullptr;
+
+      const auto status =
+          text_iterator_.GetNextWord(&word, &word_start, &word_length);
+      if (status == SpellcheckWordIterator::IS_END_OF_TEXT)
+        break;
+      if (status == SpellcheckWordIterator::IS_SKIPPABLE)
+        continue;
+
+      word_entry.result.location = base::checked_cast<int>(word_start);
+      word_entry.result.length = base::checked_cast<int>(word_length);
+      word_entry.text = word;
+      word_entry.contraction_words.clear();
+
+      tokenized->words.insert(word);
+      // If the given word is a concatenated word of two or more valid words
+      // (e.g. "hello:hello"), we should treat it as a valid word.
+      if (IsContraction(word, &word_entry.contraction_words)) {
+        for (const auto& w : word_entry.contraction_words) {
+          tokenized->words.insert(w);
+        }
+      }
+      tokenized->word_list.push_back(word_entry);
+    }
+    return tokenized;
+  }
+
+ private:
+  // Returns whether or not the given string is a contraction.
+  // This function is a fall-back when the SpellcheckWordIterator class
+  // returns a concatenated word which is not in the selected dictionary
+  // (e.g. "in'n'out") but each word is valid.
+  // Output variable contraction_words will contain individual
+  // words in the contraction.
+  bool IsContraction(const std::u16string& contraction,
+                     std::vector<std::u16string>* contraction_words) {
+    DCHECK(contraction_iterator_.IsInitialized());
+
+    contraction_iterator_.SetText(contraction.c_str(), contraction.length());
+
+    std::u16string word;
+    size_t word_start;
+    size_t word_length;
+    for (auto status = contraction_iterator_.GetNextWord(&word, &word_start,
+                                                         &word_length);
+         status != SpellcheckWordIterator::IS_END_OF_TEXT;
+         status = contraction_iterator_.GetNextWord(&word, &word_start,
+                                                    &word_length)) {
+      if (status == SpellcheckWordIterator::IS_SKIPPABLE)
+        continue;
+
+      contraction_words->push_back(word);
+    }
+    return contraction_words->size() > 1;
+  }
+
+  SpellcheckCharAttribute character_attributes_;
+  SpellcheckWordIterator text_iterator_;
+  SpellcheckWordIterator contraction_iterator_;
+};
+
 class SpellCheckClient::SpellcheckRequest {
  public:
   SpellcheckRequest(
+      uint64_t id,
       const std::u16string& text,
       std::unique_ptr<blink::WebTextCheckingCompletion> completion)
-      : text_(text), completion_(std::move(completion)) {}
+      : id_(id),
+        text_(text),
+        completion_(std::move(completion)),
+        cancelled_(base::MakeRefCounted<CancellationFlag>()) {}
   SpellcheckRequest(const SpellcheckRequest&) = delete;
   SpellcheckRequest& operator=(const SpellcheckRequest&) = delete;
   ~SpellcheckRequest() = default;
 
+  uint64_t id() const { return id_; }
   const std::u16string& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
-  std::vector<Word>& wordlist() { return word_list_; }
+  const scoped_refptr<CancellationFlag>& cancelled() const {
+    return cancelled_;
+  }
+  std::unique_ptr<TokenizedText>& tokenized() { return tokenized_; }
+  // Words of this request that the cache knows to be misspelled.
+  std::vector<std::u16string>& cached_misspelled_words() {
+    return cached_misspelled_words_;
+  }
 
  private:
-  std::u16string text_;          // Text to be checked in this task.
-  std::vector<Word> word_list_;  // List of Words found in text
+  uint64_t id_;
+  std::u16string text_;  // Text to be checked in this task.
   // The interface to send the misspelled ranges to WebKit.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
+  // Set when a newer request replaces this one.
+  scoped_refptr<CancellationFlag> cancelled_;
+  std::unique_ptr<TokenizedText> tokenized_;
+  std::vector<std::u16string> cached_misspelled_words_;
 };
 
 SpellCheckClient::SpellCheckClient(const std::string& language,
                                    v8::Isolate* isolate,
                                    v8::Local<v8::Object> provider)
-    : isolate_(isolate),
+    : language_(language),
+      tokenizer_(std::make_unique<WordTokenizer>(language)),
+      word_cache_(kWordCacheSize),
+      isolate_(isolate),
       context_(isolate, isolate->GetCurrentContext()),
       provider_(isolate, provider) {
   DCHECK(!context_.IsEmpty());
 
-  character_attributes_.SetDefaultLanguage(language);
-
   // Persistent the method.
   v8::Local<v8::Function> spell_check;
   gin_helper::Dictionary(isolate, provider).Get("spellCheck", &spell_check);
@@ -86,6 +223,8 @@ SpellCheckClient::SpellCheckClient(const std::string& language,
 }
 
 SpellCheckClient::~SpellCheckClient() {
+  if (pending_request_param_)
+    pending_request_param_->cancelled()->data.Set();
   context_.Reset();
 }
 
@@ -100,12 +239,14 @@ void SpellCheckClient::RequestCheckingOfText(
   }
 
   // Clean up the previous request before starting a new request.
-  if (pending_request_param_) {
-    pending_request_param_->completion()->DidCancelCheckingText();
-  }
+  if (pending_request_param_)
+    CancelRequest();
 
-  pending_request_param_ =
-      std::make_unique<SpellcheckRequest>(text, std::move(completionCallback));
+  pending_request_param_ = std::make_unique<SpellcheckRequest>(
+      ++next_request_id_, text, std::move(completionCallback));
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+      "electron", "SpellCheckClient::RequestCheckingOfText",
+      TRACE_ID_LOCAL(next_request_id_), "length", text.size());
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
@@ -126,95 +267,146 @@ void SpellCheckClient::UpdateSpellingUIWithMisspelledWord(
     const blink::WebString& word) {}
 
 void SpellCheckClient::SpellCheckText() {
+  if (!pending_request_param_)
+    return;
+
   const auto& text = pending_request_param_->text();
   if (text.empty() || spell_check_.IsEmpty()) {
-    pending_request_param_->completion()->DidCancelCheckingText();
-    pending_request_param_ = nullptr;
+    CancelRequest();
     return;
   }
 
-  if (!text_iterator_.IsInitialized() &&
-      !text_iterator_.Initialize(&character_attributes_, true)) {
-    // We failed to initialize text_iterator_, return as spelled correctly.
-    VLOG(1) << "Failed to initialize SpellcheckWordIterator";
+  uint64_t request_id = pending_request_param_->id();
+  if (text.size() < kBackgroundTokenizeThreshold) {
+    OnTextTokenized(request_id, tokenizer_->Tokenize(text, nullptr));
     return;
   }
 
-  if (!contraction_iterator_.IsInitialized() &&
-      !contraction_iterator_.Initialize(&character_attributes_, false)) {
-    // We failed to initialize the word iterator, return as spelled correctly.
-    VLOG(1) << "Failed to initialize contraction_iterator_";
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&SpellCheckClient::TokenizeInBackground, language_, text,
+                     pending_request_param_->cancelled()),
+      base::BindOnce(&SpellCheckClient::OnTextTokenized, AsWeakPtr(),
+                     request_id));
+}
+
+// static
+std::unique_ptr<SpellCheckClient::TokenizedText>
+SpellCheckClient::TokenizeInBackground(
+    const std::string& language,
+    const std::u16string& text,
+    scoped_refptr<CancellationFlag> cancelled) {
+  TRACE_EVENT1("electron", "SpellCheckClient::TokenizeInBackground", "length",
+               text.size());
+  WordTokenizer tokenizer(language);
+  return tokenizer.Tokenize(text, &cancelled->data);
+}
+
+void SpellCheckClient::OnTextTokenized(
+    uint64_t request_id,
+    std::unique_ptr<TokenizedText> tokenized) {
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
     return;
-  }
 
-  text_iterator_.SetText(text.c_str(), text.size());
+  if (!tokenized) {
+    // We failed to initialize the word iterators, return as spelled correctly.
+    FinishRequest({});
+    return;
+  }
 
-  SpellCheckScope scope(*this);
-  std::u16string word;
-  size_t word_start;
-  size_t word_length;
-  std::set<std::u16string> words;
-  auto& word_list = pending_request_param_->wordlist();
-  Word word_entry;
-  for (;;) {  // Run until end of text
-    const auto status =
-        text_iterator_.GetNextWord(&word, &word_start, &word_length);
-    if (status == SpellcheckWordIterator::IS_END_OF_TEXT)
-      break;
-    if (status == SpellcheckWordIterator::IS_SKIPPABLE)
-      continue;
-
-    word_entry.result.location = base::checked_cast<int>(word_start);
-    word_entry.result.length = base::checked_cast<int>(word_length);
-    word_entry.text = word;
-    word_entry.contraction_words.clear();
-
-    word_list.push_back(word_entry);
-    words.insert(word);
-    // If the given word is a concatenated word of two or more valid words
-    // (e.g. "hello:hello"), we should treat it as a valid word.
-    if (IsContraction(scope, word, &word_entry.contraction_words)) {
-      for (const auto& w : word_entry.contraction_words) {
-        words.insert(w);
-      }
+  std::set<std::u16string> unchecked_words;
+  auto& cached_misspelled_words =
+      pending_request_param_->cached_misspelled_words();
+  for (const auto& word : tokenized->words) {
+    auto it = word_cache_.Get(word);
+    if (it == word_cache_.end()) {
+      unchecked_words.insert(word);
+    } else if (!it->second) {
+      cached_misspelled_words.push_back(word);
     }
   }
+  pending_request_param_->tokenized() = std::move(tokenized);
 
-  // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
+  if (unchecked_words.empty()) {
+    FinishRequest({});
+    return;
+  }
+
+  // Send out the words that have not been checked yet to the spellchecker
+  SpellCheckScope scope(*this);
+  SpellCheckWords(scope, request_id, unchecked_words);
 }
 
 void SpellCheckClient::OnSpellCheckDone(
+    uint64_t request_id,
+    const std::set<std::u16string>& checked_words,
     const std::vector<std::u16string>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
   std::unordered_set<std::u16string> misspelled(misspelled_words.begin(),
                                                 misspelled_words.end());
+  for (const auto& word : checked_words)
+    word_cache_.Put(word, misspelled.find(word) == misspelled.end());
+  for (const auto& word : misspelled)
+    word_cache_.Put(word, false);
 
-  auto& word_list = pending_request_param_->wordlist();
-
-  for (const auto& word : word_list) {
-    if (misspelled.find(word.text) != misspelled.end()) {
-      // If this is a contraction, iterate through parts and accept the word
-      // if none of them are misspelled
-      if (!word.contraction_words.empty()) {
-        auto all_correct = true;
-        for (const auto& contraction_word : word.contraction_words) {
-          if (misspelled.find(contraction_word) != misspelled.end()) {
-            all_correct = false;
-            break;
+  // The results of replaced requests are only used to fill the cache.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+
+  FinishRequest(misspelled_words);
+}
+
+void SpellCheckClient::FinishRequest(
+    const std::vector<std::u16string>& misspelled_words) {
+  std::vector<blink::WebTextCheckingResult> results;
+  std::unordered_set<std::u16string> misspelled(misspelled_words.begin(),
+                                                misspelled_words.end());
+  const auto& cached_misspelled_words =
+      pending_request_param_->cached_misspelled_words();
+  misspelled.insert(cached_misspelled_words.begin(),
+                    cached_misspelled_words.end());
+
+  if (!misspelled.empty()) {
+    for (const auto& word : pending_request_param_->tokenized()->word_list) {
+      if (misspelled.find(word.text) != misspelled.end()) {
+        // If this is a contraction, iterate through parts and accept the word
+        // if none of them are misspelled
+        if (!word.contraction_words.empty()) {
+          auto all_correct = true;
+          for (const auto& contraction_word : word.contraction_words) {
+            if (misspelled.find(contraction_word) != misspelled.end()) {
+              all_correct = false;
+              break;
+            }
           }
+          if (all_correct)
+            continue;
         }
-        if (all_correct)
-          continue;
+        results.push_back(word.result);
       }
-      results.push_back(word.result);
     }
   }
+
+  TRACE_EVENT_NESTABLE_ASYNC_END1(
+      "electron", "SpellCheckClient::RequestCheckingOfText",
+      TRACE_ID_LOCAL(pending_request_param_->id()), "misspelled",
+      results.size());
   pending_request_param_->completion()->DidFinishCheckingText(results);
   pending_request_param_ = nullptr;
 }
 
+void SpellCheckClient::CancelRequest() {
+  pending_request_param_->cancelled()->data.Set();
+  TRACE_EVENT_NESTABLE_ASYNC_END0(
+      "electron", "SpellCheckClient::RequestCheckingOfText",
+      TRACE_ID_LOCAL(pending_request_param_->id()));
+  pending_request_param_->completion()->DidCancelCheckingText();
+  pending_request_param_ = nullptr;
+}
+
 void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
+                                       uint64_t request_id,
                                        const std::set<std::u16string>& words) {
   DCHECK(!scope.spell_check_.IsEmpty());
 
@@ -222,8 +414,8 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
       isolate_, v8::MicrotasksScope::kDoNotRunMicrotasks);
 
   v8::Local<v8::FunctionTemplate> templ = gin_helper::CreateFunctionTemplate(
-      isolate_,
-      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr()));
+      isolate_, base::BindRepeating(&SpellCheckClient::OnSpellCheckDone,
+                                    AsWeakPtr(), request_id, words));
 
   auto context = isolate_->GetCurrentContext();
   v8::Local<v8::Value> args[] = {gin::ConvertToV8(isolate_, words),
@@ -232,36 +424,6 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
   scope.spell_check_->Call(context, scope.provider_, 2, args).IsEmpty();
 }
 
-// Returns whether or not the given string is a contraction.
-// This function is a fall-back when the SpellcheckWordIterator class
-// returns a concatenated word which is not in the selected dictionary
-// (e.g. "in'n'out") but each word is valid.
-// Output variable contraction_words will contain individual
-// words in the contraction.
-bool SpellCheckClient::IsContraction(
-    const SpellCheckScope& scope,
-    const std::u16string& contraction,
-    std::vector<std::u16string>* contraction_words) {
-  DCHECK(contraction_iterator_.IsInitialized());
-
-  contraction_iterator_.SetText(contraction.c_str(), contraction.length());
-
-  std::u16string word;
-  size_t word_start;
-  size_t word_length;
-  for (auto status =
-           contraction_iterator_.GetNextWord(&word, &word_start, &word_length);
-       status != SpellcheckWordIterator::IS_END_OF_TEXT;
-       status = contraction_iterator_.GetNextWord(&word, &word_start,
-                                                  &word_length)) {
-    if (status == SpellcheckWordIterator::IS_SKIPPABLE)
-      continue;
-
-    contraction_words->push_back(word);
-  }
-  return contraction_words->size() > 1;
-}
-
 SpellCheckClient::SpellCheckScope::SpellCheckScope(
     const SpellCheckClient& client)
     : handle_scope_(client.isolate_),
@@ -11,8 +11,10 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
-#include "components/spellcheck/renderer/spellcheck_worditerator.h"
+#include "base/synchronization/atomic_flag.h"
 #include "third_party/blink/public/platform/web_spell_check_panel_host_client.h"
 #include "third_party/blink/public/platform/web_vector.h"
 #include "third_party/blink/public/web/web_text_check_client.h"
@@ -38,6 +40,10 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
 
  private:
   class SpellcheckRequest;
+  class WordTokenizer;
+  struct TokenizedText;
+  using CancellationFlag = base::RefCountedData<base::AtomicFlag>;
+
   // blink::WebTextCheckClient:
   void RequestCheckingOfText(const blink::WebString& textToCheck,
                              std::unique_ptr<blink::WebTextCheckingCompletion>
@@ -60,44 +66,52 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
     ~SpellCheckScope();
   };
 
-  // Run through the word iterator and send out requests
-  // to the JS API for checking spellings of words in the current
-  // request.
+  // Split the text of the current request into words, on a worker thread
+  // when the text is large.
   void SpellCheckText();
 
+  // Tokenizes |text| with a tokenizer of its own, so it can run on a worker
+  // thread. Stops early and returns null once |cancelled| is set.
+  static std::unique_ptr<TokenizedText> TokenizeInBackground(
+      const std::string& language,
+      const std::u16string& text,
+      scoped_refptr<CancellationFlag> cancelled);
+
+  // Looks up the words of the request in the cache and sends the remaining
+  // ones to the JS API.
+  void OnTextTokenized(uint64_t request_id,
+                       std::unique_ptr<TokenizedText> tokenized);
+
   // Call JavaScript to check spelling a word.
   // The javascript function will callback OnSpellCheckDone
   // with the results of all the misspelled words.
   void SpellCheckWords(const SpellCheckScope& scope,
+                       uint64_t request_id,
                        const std::set<std::u16string>& words);
 
-  // Returns whether or not the given word is a contraction of valid words
-  // (e.g. "word:word").
-  // Output variable contraction_words will contain individual
-  // words in the contraction.
-  bool IsContraction(const SpellCheckScope& scope,
-                     const std::u16string& contraction,
-                     std::vector<std::u16string>* contraction_words);
-
   // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<std::u16string>& misspelled_words);
+  void OnSpellCheckDone(uint64_t request_id,
+                        const std::set<std::u16string>& checked_words,
+                        const std::vector<std::u16string>& misspelled_words);
+
+  // Reports the misspelled words of the current request to blink.
+  void FinishRequest(const std::vector<std::u16string>& misspelled_words);
+  void CancelRequest();
+
+  const std::string language_;
 
-  // Represents character attributes used for filtering out characters which
-  // are not supported by this SpellCheck object.
-  SpellcheckCharAttribute character_attributes_;
+  // Tokenizes the text of small requests on the main thread.
+  std::unique_ptr<WordTokenizer> tokenizer_;
 
-  // Represents word iterators used in this spellchecker. The |text_iterator_|
-  // splits text provided by WebKit into words, contractions, or concatenated
-  // words. The |contraction_iterator_| splits a concatenated word extracted by
-  // |text_iterator_| into word components so we can treat a concatenated word
-  // consisting only of correct words as a correct word.
-  SpellcheckWordIterator text_iterator_;
-  SpellcheckWordIterator contraction_iterator_;
+  // Whether a word is spelled correctly, as reported by the JS API. Words
+  // found here are not sent to the JS API again.
+  base::HashingMRUCache<std::u16string, bool> word_cache_;
 
   // The parameters of a pending background-spellchecking request.
   // (When WebKit sends two or more requests, we cancel the previous
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
+  uint64_t next_request_id_ = 0;
 
   v8::Isolate* isolate_;
   v8::Global<v8::Context> context_;
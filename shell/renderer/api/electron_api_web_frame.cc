@@ -514,6 +514,8 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
       return gin::ConvertToV8(isolate, prefs.node_integration_in_worker);
     } else if (pref_name == options::kNodeIntegrationInSubFrames) {
       return gin::ConvertToV8(isolate, true);
+    } else if (pref_name == options::kLazyNodeEnvironment) {
+      return gin::ConvertToV8(isolate, prefs.lazy_node_environment);
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
     } else if (pref_name == options::kSpellcheck) {
       return gin::ConvertToV8(isolate, prefs.enable_spellcheck);
@@ -5,6 +5,7 @@
 #include "electron/shell/renderer/electron_api_service_impl.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -13,8 +14,10 @@
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/common/electron_constants.h"
+#include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/heap_snapshot.h"
@@ -27,6 +30,8 @@
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
+#include "third_party/blink/public/web/web_script_execution_callback.h"
+#include "third_party/blink/public/web/web_script_source.h"
 
 namespace electron {
 
@@ -97,6 +102,125 @@ void EmitIPCEvent(v8::Local<v8::Context> context,
   InvokeIpcCallback(context, "onMessage", argv);
 }
 
+using ExecuteJavaScriptCallback =
+    mojom::ElectronRenderer::ExecuteJavaScriptCallback;
+
+void ReplyWithError(ExecuteJavaScriptCallback callback,
+                    const std::string& error) {
+  std::move(callback).Run(blink::CloneableMessage(), error);
+}
+
+// Hands |value| back to the browser as a serialized V8 value, so it keeps
+// types that base::Value can not represent.
+void ReplyWithValue(v8::Isolate* isolate,
+                    v8::Local<v8::Value> value,
+                    ExecuteJavaScriptCallback callback) {
+  v8::TryCatch try_catch(isolate);
+  blink::CloneableMessage message;
+  if (!SerializeV8Value(isolate, value, &message)) {
+    std::string error_message =
+        "An unknown exception occurred while getting the result of the "
+        "script";
+    if (try_catch.HasCaught() && !try_catch.Message().IsEmpty())
+      gin::ConvertFromV8(isolate, try_catch.Message()->Get(), &error_message);
+    ReplyWithError(std::move(callback), error_message);
+    return;
+  }
+  std::move(callback).Run(std::move(message), absl::nullopt);
+}
+
+// Replies once |promise| settles, like the promise returned by
+// webFrame.executeJavaScript adopts the state of a returned promise.
+void ReplyWhenSettled(v8::Isolate* isolate,
+                      v8::Local<v8::Context> context,
+                      v8::Local<v8::Promise> promise,
+                      ExecuteJavaScriptCallback callback) {
+  // Only one of the handlers runs, they share the callback. A promise that
+  // never settles gets its handlers garbage collected, which must still
+  // answer the browser.
+  auto shared_callback = std::make_shared<ExecuteJavaScriptCallback>(
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          std::move(callback), blink::CloneableMessage(),
+          absl::optional<std::string>("Promise was garbage collected")));
+  auto then_cb = base::BindOnce(
+      [](std::shared_ptr<ExecuteJavaScriptCallback> callback,
+         v8::Isolate* isolate, v8::Local<v8::Value> value) {
+        if (*callback)
+          ReplyWithValue(isolate, value, std::move(*callback));
+      },
+      shared_callback, isolate);
+  auto catch_cb = base::BindOnce(
+      [](std::shared_ptr<ExecuteJavaScriptCallback> callback,
+         v8::Isolate* isolate, v8::Local<v8::Value> reason) {
+        if (!*callback)
+          return;
+        std::string error_message;
+        gin::ConvertFromV8(isolate,
+                           v8::Exception::CreateMessage(isolate, reason)->Get(),
+                           &error_message);
+        ReplyWithError(std::move(*callback), error_message);
+      },
+      shared_callback, isolate);
+
+  ignore_result(promise->Then(
+      context, gin::ConvertToV8(isolate, then_cb).As<v8::Function>(),
+      gin::ConvertToV8(isolate, catch_cb).As<v8::Function>()));
+}
+
+// Hands the result of a script run for the browser back as a serialized V8
+// value, so it keeps types that base::Value can not represent.
+class SerializedResultCallback : public blink::WebScriptExecutionCallback {
+ public:
+  SerializedResultCallback(v8::Isolate* isolate,
+                           v8::Local<v8::Context> context,
+                           ExecuteJavaScriptCallback callback)
+      : isolate_(isolate),
+        context_(isolate, context),
+        callback_(std::move(callback)) {}
+  ~SerializedResultCallback() override = default;
+
+  void Completed(
+      const blink::WebVector<v8::Local<v8::Value>>& result) override {
+    Reply(result);
+    delete this;
+  }
+
+ private:
+  void Reply(const blink::WebVector<v8::Local<v8::Value>>& result) {
+    if (result.empty()) {
+      ReplyWithError(
+          std::move(callback_),
+          "WebFrame was removed before script could run. This normally means "
+          "the underlying frame was destroyed");
+      return;
+    }
+    if (result[0].IsEmpty()) {
+      ReplyWithError(
+          std::move(callback_),
+          "Script failed to execute, this normally means an error "
+          "was thrown. Check the renderer console for the error.");
+      return;
+    }
+
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Context> context = context_.Get(isolate_);
+    v8::Context::Scope context_scope(context);
+    // Script execution does not wait for returned promises.
+    if (result[0]->IsPromise()) {
+      ReplyWhenSettled(isolate_, context, result[0].As<v8::Promise>(),
+                       std::move(callback_));
+      return;
+    }
+    ReplyWithValue(isolate_, result[0], std::move(callback_));
+  }
+
+  v8::Isolate* isolate_;
+  v8::Global<v8::Context> context_;
+  ExecuteJavaScriptCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializedResultCallback);
+};
+
 }  // namespace
 
 ElectronApiServiceImpl::~ElectronApiServiceImpl() = default;
@@ -219,4 +343,19 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   std::move(callback).Run(success);
 }
 
+void ElectronApiServiceImpl::ExecuteJavaScript(
+    const std::u16string& code,
+    bool user_gesture,
+    ExecuteJavaScriptCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  frame->RequestExecuteScriptAndReturnValue(
+      blink::WebScriptSource(blink::WebString::FromUTF16(code)),
+      user_gesture,
+      new SerializedResultCallback(isolate, frame->MainWorldScriptContext(),
+                                   std::move(callback)));
+}
+
 }  // namespace electron
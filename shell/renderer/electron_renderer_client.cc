@@ -5,15 +5,23 @@
 #include "shell/renderer/electron_renderer_client.h"
 
 #include <string>
+#include <vector>
 
+#include "base/base_paths.h"
 #include "base/command_line.h"
+#include "base/environment.h"
+#include "base/macros.h"
+#include "base/path_service.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
+#include "gin/converter.h"
 #include "shell/common/api/electron_bindings.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/web_worker_observer.h"
@@ -25,11 +33,37 @@ namespace electron {
 
 namespace {
 
+// Globals that materialize a lazily created Node environment when the page
+// first reads or writes them.
+const char* const kLazyNodeGlobals[] = {
+    "require", "module",       "process",        "Buffer",     "global",
+    "root",    "setImmediate", "clearImmediate", "__filename", "__dirname",
+};
+
 bool IsDevToolsExtension(content::RenderFrame* render_frame) {
   return static_cast<GURL>(render_frame->GetWebFrame()->GetDocument().Url())
       .SchemeIs("chrome-extension");
 }
 
+bool IsDevTools(content::RenderFrame* render_frame) {
+  return static_cast<GURL>(render_frame->GetWebFrame()->GetDocument().Url())
+      .SchemeIs("devtools");
+}
+
+// The value of process.platform, which the security warnings need in frames
+// that never get a Node environment.
+const char* GetPlatform() {
+#if defined(OS_WIN)
+  return "win32";
+#elif defined(OS_MAC)
+  return "darwin";
+#elif defined(OS_FREEBSD)
+  return "freebsd";
+#else
+  return "linux";
+#endif
+}
+
 }  // namespace
 
 ElectronRendererClient::ElectronRendererClient()
@@ -70,9 +104,6 @@ void ElectronRendererClient::RunScriptsAtDocumentEnd(
 void ElectronRendererClient::DidCreateScriptContext(
     v8::Handle<v8::Context> renderer_context,
     content::RenderFrame* render_frame) {
-  // TODO(zcbenz): Do not create Node environment if node integration is not
-  // enabled.
-
   // Only load Node.js if we are a main frame or a devtools extension
   // unless Node.js support has been explicitly enabled for subframes.
   auto prefs = render_frame->GetBlinkPreferences();
@@ -86,6 +117,153 @@ void ElectronRendererClient::DidCreateScriptContext(
   if (!should_load_node)
     return;
 
+  // A frame without node integration or preload scripts can never use its
+  // Node environment, so only the window overrides and internal IPC are set
+  // up for it by the lazy bundle.
+  bool needs_node = prefs.node_integration ||
+                    prefs.node_integration_in_sub_frames ||
+                    !prefs.preload.empty() || !prefs.preloads.empty() ||
+                    prefs.webview_tag || is_devtools || IsDevTools(render_frame);
+  if (!needs_node) {
+    RunLazyBundle(renderer_context, render_frame);
+    return;
+  }
+
+  // With lazyNodeEnvironment the environment is only created once the page
+  // touches the Node globals, while the window overrides and internal IPC
+  // are set up right away by the lazy bundle. This is not possible when
+  // preload scripts or the webview tag have to run before the page, or when
+  // window.open has to be overridden.
+  bool should_defer_node = prefs.lazy_node_environment && !is_devtools &&
+                           prefs.preload.empty() && prefs.preloads.empty() &&
+                           !prefs.webview_tag && prefs.native_window_open;
+  if (should_defer_node) {
+    deferred_frames_.insert(render_frame);
+    RunLazyBundle(renderer_context, render_frame);
+    // The Node globals are only visible to the page when they live in the
+    // main world.
+    if (prefs.node_integration && !prefs.context_isolation)
+      InstallLazyNodeGlobals(renderer_context, render_frame);
+    return;
+  }
+
+  CreateNodeEnvironment(renderer_context, render_frame);
+}
+
+void ElectronRendererClient::EnsureNodeEnvironment(
+    content::RenderFrame* render_frame) {
+  if (deferred_frames_.erase(render_frame) == 0)
+    return;
+
+  auto* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::MicrotasksScope microtasks_scope(
+      isolate, v8::MicrotasksScope::kDoNotRunMicrotasks);
+  auto context = GetContext(render_frame->GetWebFrame(), isolate);
+  v8::Context::Scope context_scope(context);
+
+  // Drop the placeholders so that the bootstrap can define the real globals.
+  auto prefs = render_frame->GetBlinkPreferences();
+  if (prefs.node_integration && !prefs.context_isolation) {
+    auto global = context->Global();
+    for (const char* name : kLazyNodeGlobals)
+      ignore_result(
+          global->Delete(context, gin::StringToSymbol(isolate, name)));
+  }
+
+  CreateNodeEnvironment(context, render_frame);
+}
+
+void ElectronRendererClient::RunLazyBundle(
+    v8::Handle<v8::Context> context,
+    content::RenderFrame* render_frame) {
+  // GetBinding looks the Electron bindings up in the list of Node's linked
+  // modules, which is only filled once the bindings are initialized.
+  if (!node_integration_initialized_) {
+    node_integration_initialized_ = true;
+    node_bindings_->Initialize();
+  }
+
+  // Wrap the bundle into a function that receives the binding object as
+  // argument.
+  auto* isolate = context->GetIsolate();
+  gin_helper::Dictionary binding = gin::Dictionary::CreateEmpty(isolate);
+  binding.SetMethod("get", GetBinding);
+
+  gin_helper::Dictionary process = gin::Dictionary::CreateEmpty(isolate);
+  binding.Set("process", process);
+  BindProcess(isolate, &process, render_frame);
+
+  // Used by the security warnings, which only read the variables that
+  // enable or disable them.
+  base::FilePath exec_path;
+  base::PathService::Get(base::FILE_EXE, &exec_path);
+  process.Set("platform", GetPlatform());
+  process.Set("execPath", exec_path);
+  gin_helper::Dictionary env = gin::Dictionary::CreateEmpty(isolate);
+  auto environment = base::Environment::Create();
+  for (const char* name : {"ELECTRON_DISABLE_SECURITY_WARNINGS",
+                           "ELECTRON_ENABLE_SECURITY_WARNINGS"}) {
+    std::string value;
+    if (environment->GetVar(name, &value))
+      env.Set(name, value);
+  }
+  process.Set("env", env);
+
+  std::vector<v8::Local<v8::String>> lazy_bundle_params = {
+      node::FIXED_ONE_BYTE_STRING(isolate, "binding")};
+
+  std::vector<v8::Local<v8::Value>> lazy_bundle_args = {binding.GetHandle()};
+
+  util::CompileAndCall(context, "electron/js2c/lazy_bundle",
+                       &lazy_bundle_params, &lazy_bundle_args, nullptr);
+}
+
+void ElectronRendererClient::InstallLazyNodeGlobals(
+    v8::Handle<v8::Context> context,
+    content::RenderFrame* render_frame) {
+  auto* isolate = context->GetIsolate();
+  auto global = context->Global();
+  auto data = v8::External::New(isolate, render_frame);
+  for (const char* name : kLazyNodeGlobals) {
+    ignore_result(global->SetAccessor(
+        context, gin::StringToSymbol(isolate, name), LazyNodeGlobalGetter,
+        LazyNodeGlobalSetter, data));
+  }
+}
+
+// static
+void ElectronRendererClient::LazyNodeGlobalGetter(
+    v8::Local<v8::Name> name,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* render_frame = static_cast<content::RenderFrame*>(
+      info.Data().As<v8::External>()->Value());
+  static_cast<ElectronRendererClient*>(Get())->EnsureNodeEnvironment(
+      render_frame);
+
+  auto context = info.GetIsolate()->GetCurrentContext();
+  v8::Local<v8::Value> value;
+  if (context->Global()->Get(context, name).ToLocal(&value))
+    info.GetReturnValue().Set(value);
+}
+
+// static
+void ElectronRendererClient::LazyNodeGlobalSetter(
+    v8::Local<v8::Name> name,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void>& info) {
+  auto* render_frame = static_cast<content::RenderFrame*>(
+      info.Data().As<v8::External>()->Value());
+  static_cast<ElectronRendererClient*>(Get())->EnsureNodeEnvironment(
+      render_frame);
+
+  auto context = info.GetIsolate()->GetCurrentContext();
+  ignore_result(context->Global()->Set(context, name, value));
+}
+
+void ElectronRendererClient::CreateNodeEnvironment(
+    v8::Handle<v8::Context> renderer_context,
+    content::RenderFrame* render_frame) {
   injected_frames_.insert(render_frame);
 
   if (!node_integration_initialized_) {
@@ -133,6 +311,9 @@ void ElectronRendererClient::DidCreateScriptContext(
 void ElectronRendererClient::WillReleaseScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
+  if (deferred_frames_.erase(render_frame) != 0)
+    return;
+
   if (injected_frames_.erase(render_frame) == 0)
     return;
 
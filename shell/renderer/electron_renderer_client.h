@@ -47,6 +47,29 @@ class ElectronRendererClient : public RendererClientBase {
 
   node::Environment* GetEnvironment(content::RenderFrame* frame) const;
 
+  void CreateNodeEnvironment(v8::Handle<v8::Context> context,
+                             content::RenderFrame* render_frame);
+
+  // Creates the Node environment of a frame that deferred it, if any.
+  void EnsureNodeEnvironment(content::RenderFrame* render_frame);
+
+  // Runs the parts of the renderer init script that do not need Node in a
+  // frame that can not use Node, or whose environment has been deferred by
+  // lazyNodeEnvironment.
+  void RunLazyBundle(v8::Handle<v8::Context> context,
+                     content::RenderFrame* render_frame);
+
+  // Placeholders for the Node globals of a frame whose environment has been
+  // deferred by lazyNodeEnvironment.
+  void InstallLazyNodeGlobals(v8::Handle<v8::Context> context,
+                              content::RenderFrame* render_frame);
+  static void LazyNodeGlobalGetter(
+      v8::Local<v8::Name> name,
+      const v8::PropertyCallbackInfo<v8::Value>& info);
+  static void LazyNodeGlobalSetter(v8::Local<v8::Name> name,
+                                   v8::Local<v8::Value> value,
+                                   const v8::PropertyCallbackInfo<void>& info);
+
   // Whether the node integration has been initialized.
   bool node_integration_initialized_ = false;
 
@@ -63,6 +86,9 @@ class ElectronRendererClient : public RendererClientBase {
   // assertion, so we have to keep a book of injected web frames.
   std::set<content::RenderFrame*> injected_frames_;
 
+  // Frames that should get a Node environment but have not created it yet.
+  std::set<content::RenderFrame*> deferred_frames_;
+
   DISALLOW_COPY_AND_ASSIGN(ElectronRendererClient);
 };
 
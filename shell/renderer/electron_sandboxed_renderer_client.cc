@@ -25,14 +25,12 @@
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
-#include "third_party/electron_node/src/node_binding.h"
 
 namespace electron {
 
 namespace {
 
 const char kLifecycleKey[] = "lifecycle";
-const char kModuleCacheKey[] = "native-module-cache";
 
 bool IsDevTools(content::RenderFrame* render_frame) {
   return render_frame->GetWebFrame()->GetDocument().Url().ProtocolIs(
@@ -44,49 +42,6 @@ bool IsDevToolsExtension(content::RenderFrame* render_frame) {
       "chrome-extension");
 }
 
-v8::Local<v8::Object> GetModuleCache(v8::Isolate* isolate) {
-  auto context = isolate->GetCurrentContext();
-  gin_helper::Dictionary global(isolate, context->Global());
-  v8::Local<v8::Value> cache;
-
-  if (!global.GetHidden(kModuleCacheKey, &cache)) {
-    cache = v8::Object::New(isolate);
-    global.SetHidden(kModuleCacheKey, cache);
-  }
-
-  return cache->ToObject(context).ToLocalChecked();
-}
-
-// adapted from node.cc
-v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
-                                v8::Local<v8::String> key,
-                                gin_helper::Arguments* margs) {
-  v8::Local<v8::Object> exports;
-  std::string module_key = gin::V8ToString(isolate, key);
-  gin_helper::Dictionary cache(isolate, GetModuleCache(isolate));
-
-  if (cache.Get(module_key.c_str(), &exports)) {
-    return exports;
-  }
-
-  auto* mod = node::binding::get_linked_module(module_key.c_str());
-
-  if (!mod) {
-    char errmsg[1024];
-    snprintf(errmsg, sizeof(errmsg), "No such module: %s", module_key.c_str());
-    margs->ThrowError(errmsg);
-    return exports;
-  }
-
-  exports = v8::Object::New(isolate);
-  DCHECK_EQ(mod->nm_register_func, nullptr);
-  DCHECK_NE(mod->nm_context_register_func, nullptr);
-  mod->nm_context_register_func(exports, v8::Null(isolate),
-                                isolate->GetCurrentContext(), mod->nm_priv);
-  cache.Set(module_key.c_str(), exports);
-  return exports;
-}
-
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
                                          v8::Local<v8::String> source) {
   auto context = isolate->GetCurrentContext();
@@ -46,6 +46,7 @@
 #include "third_party/blink/public/web/web_security_policy.h"
 #include "third_party/blink/public/web/web_view.h"
 #include "third_party/blink/renderer/platform/weborigin/scheme_registry.h"  // nogncheck
+#include "third_party/electron_node/src/node_binding.h"
 
 #if defined(OS_MAC)
 #include "base/strings/sys_string_conversions.h"
@@ -108,6 +109,21 @@ std::vector<std::string> ParseSchemesCLISwitch(base::CommandLine* command_line,
 // static
 RendererClientBase* g_renderer_client_base = nullptr;
 
+const char kModuleCacheKey[] = "native-module-cache";
+
+v8::Local<v8::Object> GetModuleCache(v8::Isolate* isolate) {
+  auto context = isolate->GetCurrentContext();
+  gin_helper::Dictionary global(isolate, context->Global());
+  v8::Local<v8::Value> cache;
+
+  if (!global.GetHidden(kModuleCacheKey, &cache)) {
+    cache = v8::Object::New(isolate);
+    global.SetHidden(kModuleCacheKey, cache);
+  }
+
+  return cache->ToObject(context).ToLocalChecked();
+}
+
 }  // namespace
 
 RendererClientBase::RendererClientBase() {
@@ -158,6 +174,38 @@ RendererClientBase* RendererClientBase::Get() {
   return g_renderer_client_base;
 }
 
+// static
+// adapted from node.cc
+v8::Local<v8::Value> RendererClientBase::GetBinding(
+    v8::Isolate* isolate,
+    v8::Local<v8::String> key,
+    gin_helper::Arguments* margs) {
+  v8::Local<v8::Object> exports;
+  std::string module_key = gin::V8ToString(isolate, key);
+  gin_helper::Dictionary cache(isolate, GetModuleCache(isolate));
+
+  if (cache.Get(module_key.c_str(), &exports)) {
+    return exports;
+  }
+
+  auto* mod = node::binding::get_linked_module(module_key.c_str());
+
+  if (!mod) {
+    char errmsg[1024];
+    snprintf(errmsg, sizeof(errmsg), "No such module: %s", module_key.c_str());
+    margs->ThrowError(errmsg);
+    return exports;
+  }
+
+  exports = v8::Object::New(isolate);
+  DCHECK_EQ(mod->nm_register_func, nullptr);
+  DCHECK_NE(mod->nm_context_register_func, nullptr);
+  mod->nm_context_register_func(exports, v8::Null(isolate),
+                                isolate->GetCurrentContext(), mod->nm_priv);
+  cache.Set(module_key.c_str(), exports);
+  return exports;
+}
+
 void RendererClientBase::BindProcess(v8::Isolate* isolate,
                                      gin_helper::Dictionary* process,
                                      content::RenderFrame* render_frame) {
@@ -99,6 +99,11 @@ class RendererClientBase : public content::ContentRendererClient
                    gin_helper::Dictionary* process,
                    content::RenderFrame* render_frame);
 
+  // Implements process._linkedBinding for bundles that run without Node.
+  static v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
+                                         v8::Local<v8::String> key,
+                                         gin_helper::Arguments* margs);
+
   // content::ContentRendererClient:
   void RenderThreadStarted() override;
   void ExposeInterfacesToBrowser(mojo::BinderMap* binders) override;
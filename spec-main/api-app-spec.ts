@@ -1252,6 +1252,56 @@ describe('app module', () => {
     });
   });
 
+  describe('getAppMetricsAsync() API', () => {
+    it('resolves with stats of all running electron processes', async () => {
+      const appMetrics = await app.getAppMetricsAsync();
+      expect(appMetrics).to.be.an('array').and.have.lengthOf.at.least(1);
+      for (const entry of appMetrics) {
+        expect(entry.pid).to.be.above(0);
+        expect(entry.cpu).to.have.ownProperty('percentCPUUsage').that.is.a('number');
+        expect(entry.memory).to.have.property('workingSetSize').that.is.greaterThan(0);
+      }
+      expect(appMetrics.map(entry => entry.type)).to.include('Browser');
+    });
+
+    ifit(process.platform === 'linux')('reports detailed memory and file descriptors on Linux', async () => {
+      const appMetrics = await app.getAppMetricsAsync();
+      const browser = appMetrics.find(entry => entry.type === 'Browser')!;
+      expect(browser.memory).to.have.property('proportionalSetSize').that.is.greaterThan(0);
+      expect(browser.memory).to.have.property('privateBytes').that.is.greaterThan(0);
+      expect(browser.openFileDescriptors).to.be.greaterThan(0);
+    });
+  });
+
+  describe('startAppMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopAppMetricsSampling();
+    });
+
+    it('emits app-metrics-sampled with each sample', async () => {
+      app.startAppMetricsSampling({ interval: 10 });
+      const [, sample] = await emittedOnce(app, 'app-metrics-sampled');
+      expect(sample.timestamp).to.be.a('number').that.is.greaterThan(0);
+      expect(sample.metrics).to.be.an('array').and.have.lengthOf.at.least(1);
+    });
+
+    it('keeps at most maxSamples samples', async () => {
+      app.startAppMetricsSampling({ interval: 10, maxSamples: 2 });
+      for (let i = 0; i < 3; i++) {
+        await emittedOnce(app, 'app-metrics-sampled');
+      }
+      const samples = app.getAppMetricsSamples();
+      expect(samples).to.have.lengthOf(2);
+      expect(samples[0].timestamp).to.be.at.most(samples[1].timestamp);
+      expect(app.getAppMetricsSamples(samples[0].timestamp)).to.deep.equal([samples[1]]);
+    });
+
+    it('rejects invalid options', () => {
+      expect(() => app.startAppMetricsSampling({ interval: 0 })).to.throw(/interval must be a positive number/);
+      expect(() => app.startAppMetricsSampling({ maxSamples: -1 })).to.throw(/maxSamples must be a positive integer/);
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
@@ -0,0 +1,94 @@
+import { expect } from 'chai';
+import { app, BrowserWindow, BrowserWindowPool } from 'electron/main';
+import { emittedOnce } from './events-helpers';
+import { closeAllWindows } from './window-helpers';
+import { delay } from './spec-helpers';
+
+describe('BrowserWindowPool module', () => {
+  let pool: BrowserWindowPool | null = null;
+
+  afterEach(async () => {
+    if (pool) pool.destroy();
+    pool = null;
+    await closeAllWindows();
+  });
+
+  const waitForSpares = async (count: number) => {
+    while (pool!.getMetrics().available < count) {
+      await delay(10);
+    }
+  };
+
+  it('hands out pre-warmed windows', async () => {
+    pool = new BrowserWindowPool({ size: 2, windowOptions: { width: 300, height: 200 } });
+    await waitForSpares(2);
+    const win = pool.acquire();
+    expect(win).to.be.an.instanceOf(BrowserWindow);
+    expect(win.isVisible()).to.be.false();
+    expect(win.getSize()).to.deep.equal([300, 200]);
+    expect(win.webContents.getURL()).to.equal('about:blank');
+    expect(pool.getMetrics()).to.include({ hits: 1, misses: 0 });
+  });
+
+  it('creates a window when no spare is ready', () => {
+    pool = new BrowserWindowPool({ size: 0 });
+    const win = pool.acquire();
+    expect(win).to.be.an.instanceOf(BrowserWindow);
+    expect(pool.getMetrics()).to.include({ hits: 0, misses: 1, available: 0 });
+  });
+
+  it('refills after a window is acquired', async () => {
+    pool = new BrowserWindowPool({ size: 1 });
+    await waitForSpares(1);
+    pool.acquire();
+    await waitForSpares(1);
+    expect(pool.getMetrics().available).to.equal(1);
+  });
+
+  it('drops spare windows that are closed', async () => {
+    pool = new BrowserWindowPool({ size: 1 });
+    await waitForSpares(1);
+    const [spare] = BrowserWindow.getAllWindows();
+    const closed = emittedOnce(spare, 'closed');
+    spare.destroy();
+    await closed;
+    expect(pool.getMetrics().available).to.equal(0);
+  });
+
+  it('shrinks when size is lowered', async () => {
+    pool = new BrowserWindowPool({ size: 2 });
+    await waitForSpares(2);
+    pool.size = 1;
+    expect(pool.size).to.equal(1);
+    expect(pool.getMetrics().available).to.equal(1);
+  });
+
+  it('evicts spare windows on memory pressure', async () => {
+    pool = new BrowserWindowPool({ size: 2 });
+    await waitForSpares(2);
+    app.emit('-memory-pressure' as any, 'critical');
+    expect(pool.getMetrics()).to.include({ evictions: 2, available: 0 });
+    // Warming resumes once the pool is used again.
+    pool.acquire();
+    await waitForSpares(2);
+  });
+
+  it('rejects an invalid size', () => {
+    expect(() => new BrowserWindowPool({ size: -1 })).to.throw(/size must be a non-negative integer/);
+  });
+
+  it('can not be used once destroyed', () => {
+    pool = new BrowserWindowPool({ size: 0 });
+    pool.destroy();
+    expect(() => pool!.acquire()).to.throw(/destroyed/);
+  });
+
+  it('does not count destroyed spare windows as evictions', async () => {
+    pool = new BrowserWindowPool({ size: 1 });
+    await waitForSpares(1);
+    const listeners = app.listenerCount('will-quit');
+    pool.destroy();
+    expect(pool.getMetrics()).to.include({ evictions: 0, available: 0 });
+    expect(app.listenerCount('will-quit')).to.equal(listeners - 1);
+  });
+});
@@ -518,6 +518,20 @@ describe('BrowserWindow module', () => {
           w.loadFile(path.join(fixtures, 'pages', 'will-navigate.html'));
         });
 
+        it('reflects preventDefault() in event.defaultPrevented', (done) => {
+          w.webContents.once('will-navigate', (e) => {
+            try {
+              expect(e.defaultPrevented).to.be.false();
+              e.preventDefault();
+              expect(e.defaultPrevented).to.be.true();
+              done();
+            } catch (e) {
+              done(e);
+            }
+          });
+          w.loadFile(path.join(fixtures, 'pages', 'will-navigate.html'));
+        });
+
         it('is triggered when navigating from file: to http:', async () => {
           await w.loadFile(path.join(fixtures, 'api', 'blank.html'));
           w.webContents.executeJavaScript(`location.href = ${JSON.stringify(url)}`);
@@ -2161,6 +2175,99 @@ describe('BrowserWindow module', () => {
         expect(typeofProcess).to.equal('undefined');
         expect(typeofBuffer).to.equal('undefined');
       });
+
+      it('overrides window functions without node integration', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            contextIsolation: false
+          }
+        });
+        await w.loadURL('about:blank');
+        const typeofProcess = await w.webContents.executeJavaScript('typeof process');
+        expect(typeofProcess).to.equal('undefined');
+        const closed = emittedOnce(w, 'closed');
+        w.webContents.executeJavaScript('window.close()');
+        await closed;
+      });
+    });
+
+    describe('"lazyNodeEnvironment" option', () => {
+      afterEach(closeAllWindows);
+
+      it('creates the environment when the page first uses require', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            contextIsolation: false,
+            lazyNodeEnvironment: true
+          }
+        });
+        await w.loadURL('data:text/html,<script>window.before = typeof Object.getOwnPropertyDescriptor(window, "require").get; window.result = typeof require("fs").readFileSync</script>');
+        const [before, result] = await w.webContents.executeJavaScript('[window.before, window.result]');
+        expect(before).to.equal('function');
+        expect(result).to.equal('function');
+      });
+
+      it('handles internal messages without creating the environment', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            contextIsolation: false,
+            lazyNodeEnvironment: true
+          }
+        });
+        await w.loadURL('about:blank');
+        const deferred = await w.webContents.executeJavaScript('typeof Object.getOwnPropertyDescriptor(window, "process").get');
+        expect(deferred).to.equal('function');
+      });
+
+      it('overrides window functions before the environment is created', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            lazyNodeEnvironment: true
+          }
+        });
+        await w.loadURL('about:blank');
+        const closed = emittedOnce(w, 'closed');
+        w.webContents.executeJavaScript('window.close()');
+        await closed;
+      });
+
+      it('keeps the window overrides once the environment is created', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            contextIsolation: false,
+            lazyNodeEnvironment: true
+          }
+        });
+        await w.loadURL('about:blank');
+        const typeofRequire = await w.webContents.executeJavaScript('typeof require');
+        expect(typeofRequire).to.equal('function');
+        const closed = emittedOnce(w, 'closed');
+        w.webContents.executeJavaScript('window.close()');
+        await closed;
+      });
+
+      it('creates the environment eagerly when there is a preload script', async () => {
+        const preload = path.join(fixtures, 'module', 'send-later.js');
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            preload,
+            contextIsolation: false,
+            lazyNodeEnvironment: true
+          }
+        });
+        w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+        const [, typeofProcess] = await emittedOnce(ipcMain, 'answer');
+        expect(typeofProcess).to.equal('undefined');
+      });
     });
 
     describe('"sandbox" option', () => {
@@ -4571,5 +4678,63 @@ describe('BrowserWindow module', () => {
         expect(w.webContents.frameRate).to.equal(30);
       });
     });
+
+    describe('offscreen video formats', () => {
+      const nextVideoFrame = () => new Promise<any>((resolve) => {
+        w.webContents.once('video-frame', (event, frame) => {
+          // The planes are only readable while the listener runs.
+          resolve({
+            ...frame,
+            planes: frame.planes.map(({ data, stride }) => ({ length: data.length, stride }))
+          });
+        });
+      });
+
+      it('defaults to argb', () => {
+        expect(w.webContents.getOffscreenVideoFormat()).to.equal('argb');
+      });
+
+      it('rejects unknown formats', () => {
+        expect(() => w.webContents.setOffscreenVideoFormat('rgb565' as any)).to.throw(/Invalid offscreen video format/);
+      });
+
+      it('emits i420 frames', async () => {
+        w.webContents.setOffscreenVideoFormat('i420');
+        expect(w.webContents.getOffscreenVideoFormat()).to.equal('i420');
+        const videoFrame = nextVideoFrame();
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        const frame = await videoFrame;
+        expect(frame.format).to.equal('i420');
+        expect(frame.timestamp).to.be.a('number');
+        expect(frame.colorSpace).to.have.property('matrix');
+        expect(frame.planes).to.have.lengthOf(3);
+        const [y, u, v] = frame.planes;
+        expect(y.stride).to.be.at.least(frame.codedSize.width);
+        expect(y.length).to.equal(y.stride * frame.codedSize.height);
+        expect(u.stride).to.equal(Math.ceil(frame.codedSize.width / 2));
+        expect(u.length).to.equal(u.stride * Math.ceil(frame.codedSize.height / 2));
+        expect(v.length).to.equal(u.length);
+      });
+
+      it('emits nv12 frames', async () => {
+        w.webContents.setOffscreenVideoFormat('nv12');
+        const videoFrame = nextVideoFrame();
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        const frame = await videoFrame;
+        expect(frame.format).to.equal('nv12');
+        expect(frame.planes).to.have.lengthOf(2);
+        const [y, uv] = frame.planes;
+        expect(y.length).to.equal(y.stride * frame.codedSize.height);
+        expect(uv.stride).to.be.at.least(frame.codedSize.width);
+      });
+
+      it('empties the planes once the listener returns', async () => {
+        w.webContents.setOffscreenVideoFormat('i420');
+        const videoFrame = emittedOnce(w.webContents, 'video-frame');
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        const [, frame] = await videoFrame;
+        expect(frame.planes[0].data.length).to.equal(0);
+      });
+    });
   });
 });
@@ -543,6 +543,56 @@ describe('contextBridge', () => {
         expect(result).to.deep.equal([true, true]);
       });
 
+      it('should transfer array buffers marked with contextBridge.transfer', async () => {
+        await makeBindingWindow(() => {
+          let source: Uint8Array;
+          contextBridge.exposeInMainWorld('example', {
+            get: () => {
+              source = new Uint8Array([1, 2, 3, 4]);
+              return contextBridge.transfer(source);
+            },
+            sourceLength: () => source.byteLength
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const transferred = root.example.get();
+          return [
+            Object.getPrototypeOf(transferred) === Uint8Array.prototype,
+            Array.from(transferred),
+            root.example.sourceLength()
+          ];
+        });
+        expect(result).to.deep.equal([true, [1, 2, 3, 4], 0]);
+      });
+
+      it('should copy array buffers that were not marked for transfer', async () => {
+        await makeBindingWindow(() => {
+          const source = new Uint8Array([1, 2, 3, 4]);
+          contextBridge.exposeInMainWorld('example', {
+            get: () => source,
+            sourceLength: () => source.byteLength
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          return [Array.from(root.example.get()), root.example.sourceLength()];
+        });
+        expect(result).to.deep.equal([[1, 2, 3, 4], 4]);
+      });
+
+      it('should throw when marking a partial view for transfer', async () => {
+        await makeBindingWindow(() => {
+          let error: string = '';
+          try {
+            contextBridge.transfer(new Uint8Array(new ArrayBuffer(8), 4));
+          } catch (e) {
+            error = e.message;
+          }
+          contextBridge.exposeInMainWorld('example', error);
+        });
+        const result = await callWithBindings((root: any) => root.example);
+        expect(result).to.match(/spans its entire detachable ArrayBuffer/);
+      });
+
       it('should handle recursive objects', async () => {
         await makeBindingWindow(() => {
           const o: any = { value: 135 };
@@ -557,6 +607,21 @@ describe('contextBridge', () => {
         expect(result).to.deep.equal([135, 135, 135]);
       });
 
+      it('should preserve identity of objects shared many times in one structure', async () => {
+        await makeBindingWindow(() => {
+          const shared = Array.from({ length: 1000 }, (_, i) => ({ i }));
+          contextBridge.exposeInMainWorld('example', {
+            a: shared,
+            b: shared.slice().reverse()
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const { a, b } = root.example;
+          return [a.length, a.every((o: any, i: number) => o === b[b.length - 1 - i]), a[999].i];
+        });
+        expect(result).to.deep.equal([1000, true, 999]);
+      });
+
       it('should handle DOM elements', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', {
@@ -400,6 +400,66 @@ describe('ipc module', () => {
         port1.postMessage('hello');
       });
 
+      describe('batched delivery', () => {
+        it('delivers every message in order', async () => {
+          const { port1, port2 } = new MessageChannelMain();
+          port1.enableBatching();
+          port1.start();
+          for (let i = 0; i < 100; i++) port2.postMessage(i);
+          const received: number[] = [];
+          await new Promise<void>(resolve => {
+            port1.on('message', (e) => {
+              received.push(e.data);
+              if (received.length === 100) resolve();
+            });
+          });
+          expect(received).to.deep.equal([...Array(100).keys()]);
+        });
+
+        it('delivers at most maxMessages at a time', async () => {
+          const { port1, port2 } = new MessageChannelMain();
+          port1.enableBatching({ maxMessages: 10 });
+          port1.start();
+          for (let i = 0; i < 25; i++) port2.postMessage(i);
+          // Microtasks only run between batches, so each run of messages
+          // without a microtask in between is one batch.
+          const runs: number[] = [0];
+          await new Promise<void>(resolve => {
+            let count = 0;
+            port1.on('message', () => {
+              runs[runs.length - 1]++;
+              if (runs[runs.length - 1] === 1) {
+                Promise.resolve().then(() => runs.push(0));
+              }
+              if (++count === 25) resolve();
+            });
+          });
+          for (const run of runs) expect(run).to.be.at.most(10);
+          expect(runs.length).to.be.lessThan(25);
+          expect(runs.reduce((a, b) => a + b)).to.equal(25);
+        });
+
+        it('delivers pending messages before close', async () => {
+          const { port1, port2 } = new MessageChannelMain();
+          port1.enableBatching();
+          port1.start();
+          const events: string[] = [];
+          port1.on('message', (e) => events.push(e.data));
+          const closed = emittedOnce(port1, 'close');
+          port2.postMessage('a');
+          port2.postMessage('b');
+          port2.close();
+          await closed;
+          expect(events).to.deep.equal(['a', 'b']);
+        });
+
+        it('rejects invalid options', () => {
+          const { port1 } = new MessageChannelMain();
+          expect(() => port1.enableBatching({ maxMessages: 0 })).to.throw(/maxMessages must be a positive integer/);
+          expect(() => port1.enableBatching({ maxDuration: -1 })).to.throw(/maxDuration must be a positive number/);
+        });
+      });
+
       it('throws when passing null ports', () => {
         const { port1 } = new MessageChannelMain();
         expect(() => {
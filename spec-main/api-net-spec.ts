@@ -1,6 +1,9 @@
 import { expect } from 'chai';
 import { net, session, ClientRequest, BrowserWindow, ClientRequestConstructorOptions } from 'electron/main';
+import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
 import * as url from 'url';
 import { AddressInfo, Socket } from 'net';
 import { emittedOnce } from './events-helpers';
@@ -215,6 +218,117 @@ describe('net module', () => {
       expect(chunkIndex).to.be.equal(chunkCount);
     });
 
+    it('should keep several chunked upload writes in flight', async () => {
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        response.statusCode = 200;
+        response.end(await collectStreamBodyBuffer(request));
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.chunkedEncoding = true;
+      const chunks = Array.from({ length: 64 }, () => randomBuffer(kOneKiloByte));
+      // Writes that are under the in-flight limit complete without waiting
+      // for earlier ones to reach the network.
+      const writes = chunks.map(chunk => new Promise<void>(resolve => urlRequest.write(chunk, () => resolve())));
+      const response = await getResponse(urlRequest);
+      await Promise.all(writes);
+      const received = await collectStreamBodyBuffer(response);
+      expect(received.equals(Buffer.concat(chunks))).to.be.true();
+    });
+
+    it('should not be affected by reusing a chunk buffer after its write completes', async () => {
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        response.statusCode = 200;
+        response.end(await collectStreamBodyBuffer(request));
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.chunkedEncoding = true;
+      const buffer = Buffer.alloc(kOneKiloByte);
+      const sent: Buffer[] = [];
+      for (let i = 0; i < 16; i++) {
+        const chunk = randomBuffer(kOneKiloByte);
+        chunk.copy(buffer);
+        sent.push(chunk);
+        await new Promise<void>(resolve => urlRequest.write(buffer, () => resolve()));
+        // The write has completed, so the buffer may be overwritten.
+        buffer.fill(0);
+      }
+      const response = await getResponse(urlRequest);
+      const received = await collectStreamBodyBuffer(response);
+      expect(received.equals(Buffer.concat(sent))).to.be.true();
+    });
+
+    for (const kind of ['path', 'file descriptor']) {
+      it(`should upload a file given its ${kind}`, async () => {
+        const body = randomBuffer(kOneMegaByte);
+        const uploadPath = path.join(os.tmpdir(), `electron-net-spec-upload-${Date.now()}`);
+        await fs.promises.writeFile(uploadPath, body);
+        defer(() => fs.promises.unlink(uploadPath).catch(() => {}));
+        const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+          response.statusCode = 200;
+          response.end(await collectStreamBodyBuffer(request));
+        });
+        let uploadFile: string | number = uploadPath;
+        if (kind === 'file descriptor') {
+          const fd = uploadFile = fs.openSync(uploadPath, 'r');
+          defer(() => fs.closeSync(fd));
+        }
+        const urlRequest = net.request({ method: 'POST', url: serverUrl, uploadFile });
+        const response = await getResponse(urlRequest);
+        const received = await collectStreamBodyBuffer(response);
+        expect(received.equals(body)).to.be.true();
+      });
+    }
+
+    it('should not allow writing a body when uploadFile is set', async () => {
+      const urlRequest = net.request({ method: 'POST', url: 'http://127.0.0.1', uploadFile: __filename });
+      urlRequest.on('error', () => {});
+      const error = await new Promise<Error | null | undefined>(resolve => urlRequest.write('hello', resolve));
+      expect(error).to.be.an('Error').with.property('message').that.matches(/uploadFile/);
+      expect(() => { urlRequest.chunkedEncoding = true; }).to.throw(/uploadFile/);
+    });
+
+    it('should coalesce response data when bufferSize is set', async () => {
+      const body = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.statusCode = 200;
+        for (let offset = 0; offset < body.length; offset += kOneKiloByte) {
+          response.write(body.slice(offset, offset + kOneKiloByte));
+        }
+        response.end();
+      });
+      const bufferSize = 256 * kOneKiloByte;
+      const urlRequest = net.request({ url: serverUrl, bufferSize });
+      const response = await getResponse(urlRequest);
+      const chunks: Buffer[] = [];
+      response.on('data', (chunk: Buffer) => chunks.push(chunk));
+      await emittedOnce(response, 'end');
+      expect(Buffer.concat(chunks).equals(body)).to.be.true();
+      for (const chunk of chunks) {
+        expect(chunk.length).to.be.at.most(bufferSize);
+      }
+    });
+
+    it('should reject an invalid bufferSize', () => {
+      expect(() => net.request({ url: 'http://127.0.0.1', bufferSize: 0 })).to.throw(/bufferSize must be a positive integer/);
+      expect(() => net.request({ url: 'http://127.0.0.1', bufferSize: 1.5 })).to.throw(/bufferSize must be a positive integer/);
+    });
+
+    it('should write the response body to savePath', async () => {
+      const body = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.statusCode = 200;
+        response.end(body);
+      });
+      const savePath = path.join(os.tmpdir(), `electron-net-spec-${Date.now()}`);
+      defer(() => fs.promises.unlink(savePath).catch(() => {}));
+      const urlRequest = net.request({ url: serverUrl, savePath });
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+      const received = await collectStreamBodyBuffer(response);
+      expect(received.length).to.equal(0);
+      expect((await fs.promises.readFile(savePath)).equals(body)).to.be.true();
+    });
+
     for (const extraOptions of [{}, { credentials: 'include' }, { useSessionCookies: false, credentials: 'include' }] as ClientRequestConstructorOptions[]) {
       describe(`authentication when ${JSON.stringify(extraOptions)}`, () => {
         it('should emit the login event when 401', async () => {
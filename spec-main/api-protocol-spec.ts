@@ -607,6 +607,70 @@ describe('protocol module', () => {
       expect({ ...qs.parse(r.data) }).to.deep.equal(postData);
     });
 
+    it('forwards the body of the original request', async () => {
+      const server = http.createServer((req, res) => {
+        req.pipe(res);
+      });
+      after(() => server.close());
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+
+      const port = (server.address() as AddressInfo).port;
+      interceptHttpProtocol('http', (request, callback) => {
+        callback({ url: `http://127.0.0.1:${port}` });
+      });
+      const r = await ajax('http://fake-host', { type: 'POST', data: postData });
+      expect({ ...qs.parse(r.data) }).to.deep.equal(postData);
+    });
+
+    it('fails when the handler does not give a url', async () => {
+      interceptHttpProtocol('http', (request, callback) => callback({}));
+      await expect(ajax('http://fake-host')).to.eventually.be.rejected();
+    });
+
+    it('can send a Buffer as upload data', async () => {
+      const server = http.createServer((req, res) => {
+        res.setHeader('Content-Type', req.headers['content-type']!);
+        req.pipe(res);
+      });
+      after(() => server.close());
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+
+      const port = (server.address() as AddressInfo).port;
+      interceptHttpProtocol('http', (request, callback) => {
+        callback({
+          url: `http://127.0.0.1:${port}`,
+          method: 'POST',
+          uploadData: { contentType: 'text/plain', data: Buffer.from(text) }
+        });
+      });
+      const r = await ajax('http://fake-host', { type: 'POST', data: 'ignored' });
+      expect(r.data).to.equal(text);
+      expect(r.headers).to.include('content-type: text/plain');
+    });
+
+    it('streams the response body', async () => {
+      const finish = defer();
+      const server = http.createServer((req, res) => {
+        res.write(text);
+        finish.then(() => res.end());
+      });
+      after(() => server.close());
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+
+      const port = (server.address() as AddressInfo).port;
+      interceptHttpProtocol('http', (request, callback) => {
+        callback({ url: `http://127.0.0.1:${port}` });
+      });
+      await contents.loadFile(path.join(__dirname, 'fixtures', 'pages', 'jquery.html'));
+      // The first chunk arrives while the server is still sending.
+      const firstChunk = await contents.executeJavaScript(`
+        fetch('http://fake-host').then(r => r.body.getReader().read())
+          .then(({ value }) => new TextDecoder().decode(value))
+      `);
+      finish.resolve();
+      expect(firstChunk).to.equal(text);
+    });
+
     it('can use custom session', async () => {
       const customSession = session.fromPartition('custom-ses', { cache: false });
       customSession.webRequest.onBeforeRequest((details, callback) => {
@@ -528,6 +528,58 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.getBlobDataIterator()', () => {
+    const scheme = 'cors-blob-iterator';
+    const protocol = session.defaultSession.protocol;
+    const url = `${scheme}://host`;
+    after(async () => {
+      await protocol.unregisterProtocol(scheme);
+    });
+    afterEach(closeAllWindows);
+
+    it('yields blob data for uuid in chunks', async () => {
+      const size = 1024 * 1024;
+      const content = `<html>
+                       <script>
+                       let fd = new FormData();
+                       fd.append('file', new Blob(['a'.repeat(${size})]));
+                       fetch('${url}', {method:'POST', body: fd });
+                       </script>
+                       </html>`;
+
+      const chunksPromise = new Promise<Buffer[]>((resolve, reject) => {
+        protocol.registerStringProtocol(scheme, async (request, callback) => {
+          if (request.method === 'GET') {
+            callback({ data: content, mimeType: 'text/html' });
+            return;
+          }
+          callback('');
+          try {
+            const chunks: Buffer[] = [];
+            for await (const chunk of session.defaultSession.getBlobDataIterator(request.uploadData![1].blobUUID!)) {
+              chunks.push(chunk);
+            }
+            resolve(chunks);
+          } catch (e) {
+            reject(e);
+          }
+        });
+      });
+      const w = new BrowserWindow({ show: false });
+      w.loadURL(url);
+      const chunks = await chunksPromise;
+      expect(chunks.length).to.be.greaterThan(1);
+      for (const chunk of chunks) {
+        expect(chunk.length).to.be.at.most(64 * 1024);
+      }
+      expect(Buffer.concat(chunks).toString()).to.equal('a'.repeat(size));
+    });
+
+    it('throws for an unknown uuid', () => {
+      expect(() => session.defaultSession.getBlobDataIterator('not-a-uuid')).to.throw(/Could not get blob data handle/);
+    });
+  });
+
   describe('ses.setCertificateVerifyProc(callback)', () => {
     let server: http.Server;
 
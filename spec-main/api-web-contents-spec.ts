@@ -1778,6 +1778,35 @@ describe('webContents module', () => {
       }
     });
 
+    it('can write the PDF to a file', async () => {
+      const pdfPath = path.join(app.getPath('temp'), `print-to-pdf-${Date.now()}.pdf`);
+      defer(() => fs.promises.unlink(pdfPath).catch(() => {}));
+      const data = await w.webContents.printToPDF({ path: pdfPath });
+      expect(data).to.be.an.instanceof(Buffer).that.is.empty();
+      const contents = await fs.promises.readFile(pdfPath);
+      expect(contents.slice(0, 5).toString()).to.equal('%PDF-');
+    });
+
+    it('rejects when the file can not be written', async () => {
+      const pdfPath = path.join(app.getPath('temp'), 'does-not-exist', 'nested', 'out.pdf');
+      await expect(w.webContents.printToPDF({ path: pdfPath })).to.eventually.be.rejectedWith(/Failed to write PDF/);
+      // Later requests are not affected by the failed one.
+      const data = await w.webContents.printToPDF({});
+      expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+    });
+
+    it('prints several WebContents concurrently', async () => {
+      const others = [w, new BrowserWindow({ show: false, webPreferences: { sandbox: true } })];
+      await others[1].loadURL('data:text/html,<h1>Hello again</h1>');
+      webContents.setPrintToPDFConcurrency(2);
+      defer(() => webContents.setPrintToPDFConcurrency(1));
+      const results = await Promise.all(others.map(win => win.webContents.printToPDF({})));
+      for (const data of results) {
+        expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+      }
+      expect(() => webContents.setPrintToPDFConcurrency(0)).to.throw(/concurrency must be a positive integer/);
+    });
+
     describe('using a large document', () => {
       beforeEach(async () => {
         w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } });
@@ -161,6 +161,42 @@ describe('webFrameMain module', () => {
       expect(await getUrl(webFrame.frames[0])).to.equal(fileUrl('frame-with-frame.html'));
       expect(await getUrl(webFrame.frames[0].frames[0])).to.equal(fileUrl('frame.html'));
     });
+
+    it('returns structured clones of the result', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame.html'));
+      const result = await w.webContents.mainFrame.executeJavaScript(`({
+        date: new Date(0),
+        map: new Map([['a', 1]]),
+        bytes: new Uint8Array([1, 2, 3]),
+        nothing: undefined
+      })`);
+      expect(result.date).to.be.an.instanceOf(Date);
+      expect(result.date.getTime()).to.equal(0);
+      expect(result.map).to.be.an.instanceOf(Map);
+      expect(result.map.get('a')).to.equal(1);
+      expect(result.bytes).to.be.an.instanceOf(Uint8Array);
+      expect([...result.bytes]).to.deep.equal([1, 2, 3]);
+      expect(result).to.have.property('nothing', undefined);
+    });
+
+    it('resolves with the value of a returned promise', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame.html'));
+      expect(await w.webContents.mainFrame.executeJavaScript('Promise.resolve(42)')).to.equal(42);
+    });
+
+    it('rejects with the reason of a rejected promise', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame.html'));
+      await expect(w.webContents.mainFrame.executeJavaScript('Promise.reject(new Error("boom"))')).to.eventually.be.rejectedWith(/boom/);
+    });
+
+    it('rejects when the result can not be cloned', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame.html'));
+      await expect(w.webContents.mainFrame.executeJavaScript('(() => {})')).to.eventually.be.rejected();
+    });
   });
 
   describe('WebFrame.reload', () => {
@@ -172,7 +208,7 @@ describe('webFrameMain module', () => {
       await webFrame.executeJavaScript('window.TEMP = 1', false);
       expect(webFrame.reload()).to.be.true();
       await emittedOnce(w.webContents, 'dom-ready');
-      expect(await webFrame.executeJavaScript('window.TEMP', false)).to.be.null();
+      expect(await webFrame.executeJavaScript('window.TEMP', false)).to.be.undefined();
     });
   });
 
@@ -194,6 +230,55 @@ describe('webFrameMain module', () => {
     });
   });
 
+  describe('webFrameMain.broadcast', () => {
+    const createWindow = async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          preload: path.join(subframesPath, 'preload.js'),
+          nodeIntegrationInSubFrames: true
+        }
+      });
+      await w.loadURL('about:blank');
+      return w;
+    };
+
+    it('sends to every frame', async () => {
+      const windows = [await createWindow(), await createWindow()];
+      const frames = windows.map(w => w.webContents.mainFrame);
+      const pongs = emittedNTimes(ipcMain, 'preload-pong', 2);
+      webFrameMain.broadcast(frames, 'preload-ping');
+      const routingIds = (await pongs).map(([, routingId]) => routingId);
+      expect(routingIds).to.have.members(frames.map(frame => frame.routingId));
+    });
+
+    it('skips disposed frames', async () => {
+      const disposed = await createWindow();
+      const disposedFrame = disposed.webContents.mainFrame;
+      disposed.destroy();
+      await new Promise(resolve => setTimeout(resolve, 0));
+
+      const w = await createWindow();
+      const pongPromise = emittedOnce(ipcMain, 'preload-pong');
+      webFrameMain.broadcast([disposedFrame, w.webContents.mainFrame], 'preload-ping');
+      const [, routingId] = await pongPromise;
+      expect(routingId).to.equal(w.webContents.mainFrame.routingId);
+    });
+
+    it('throws when the arguments can not be serialized', async () => {
+      const w = await createWindow();
+      expect(() => {
+        webFrameMain.broadcast([w.webContents.mainFrame], 'preload-ping', () => {});
+      }).to.throw(/Failed to serialize arguments/);
+    });
+
+    it('throws for invalid frames', () => {
+      expect(() => {
+        webFrameMain.broadcast([{} as any], 'preload-ping');
+      }).to.throw(/frames must be an array of WebFrameMain/);
+    });
+  });
+
   describe('disposed WebFrames', () => {
     let w: BrowserWindow;
     let webFrame: WebFrameMain;
@@ -75,6 +75,26 @@ describe('webRequest module', () => {
       await expect(ajax(defaultURL)).to.eventually.be.rejectedWith('404');
     });
 
+    it('sees requests from pages loaded before the first listener was added', async () => {
+      const partition = 'web-request-spec-' + Math.random();
+      const w = (webContents as any).create({ sandbox: true, partition });
+      try {
+        await w.loadFile(path.join(fixturesPath, 'pages', 'jquery.html'));
+        const { data } = await w.executeJavaScript(`ajax("${defaultURL}before")`);
+        expect(data).to.equal('/before');
+        const urls: string[] = [];
+        session.fromPartition(partition).webRequest.onBeforeRequest((details, callback) => {
+          urls.push(details.url);
+          callback({});
+        });
+        await w.executeJavaScript(`ajax("${defaultURL}after")`);
+        expect(urls).to.deep.equal([`${defaultURL}after`]);
+      } finally {
+        session.fromPartition(partition).webRequest.onBeforeRequest(null);
+        w.destroy();
+      }
+    });
+
     it('can filter URLs', async () => {
       const filter = { urls: [defaultURL + 'filter/*'] };
       ses.webRequest.onBeforeRequest(filter, (details, callback) => {
@@ -85,6 +105,30 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404');
     });
 
+    it('can filter URLs with a large number of patterns', async () => {
+      const urls = [];
+      for (let i = 0; i < 10000; i++) {
+        urls.push(`*://*.host${i}.example.com/*`, `http://host${i}.test/path/*`);
+      }
+      urls.push(defaultURL + 'filter/*');
+      ses.webRequest.onBeforeRequest({ urls }, (details, callback) => {
+        callback({ cancel: true });
+      });
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404');
+    });
+
+    it('matches file:// patterns against file URLs of any host', async () => {
+      const urls: string[] = [];
+      ses.webRequest.onBeforeRequest({ urls: ['file:///*'] }, (details, callback) => {
+        urls.push(details.url);
+        callback({ cancel: true });
+      });
+      await expect(ajax('file://server/share/x')).to.eventually.be.rejectedWith('404');
+      expect(urls).to.deep.equal(['file://server/share/x']);
+    });
+
     it('receives details object', async () => {
       ses.webRequest.onBeforeRequest((details, callback) => {
         expect(details.id).to.be.a('number');
@@ -155,6 +199,58 @@ describe('webRequest module', () => {
     });
   });
 
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules(null);
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('can block requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'blocked/*'], action: 'block' }]);
+      const { data } = await ajax(`${defaultURL}allowed/test`);
+      expect(data).to.equal('/allowed/test');
+      await expect(ajax(`${defaultURL}blocked/test`)).to.eventually.be.rejectedWith('404');
+    });
+
+    it('can redirect requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'old/*'], action: 'redirect', redirectURL: defaultURL + 'new' }]);
+      const { data } = await ajax(`${defaultURL}old/test`);
+      expect(data).to.equal('/new');
+    });
+
+    it('can modify request and response headers', async () => {
+      ses.webRequest.setRules([{
+        action: 'modifyHeaders',
+        requestHeaders: { Accept: '*/*;test/header' },
+        responseHeaders: { Custom: null, Added: 'value' }
+      }]);
+      const { data, headers } = await ajax(defaultURL);
+      expect(data).to.equal('/header/received');
+      expect(headers).to.not.match(/^custom:/m);
+      expect(headers).to.match(/^added: value$/m);
+    });
+
+    it('does not call listeners for requests it blocks', async () => {
+      const urls: string[] = [];
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        urls.push(details.url);
+        callback({});
+      });
+      ses.webRequest.setRules([{ urls: [defaultURL + 'blocked/*'], action: 'block' }]);
+      await expect(ajax(`${defaultURL}blocked/test`)).to.eventually.be.rejectedWith('404');
+      await ajax(`${defaultURL}allowed/test`);
+      expect(urls).to.deep.equal([`${defaultURL}allowed/test`]);
+    });
+
+    it('throws on invalid rules', () => {
+      expect(() => ses.webRequest.setRules([{ action: 'explode' } as any])).to.throw(/Unknown rule action/);
+      expect(() => ses.webRequest.setRules([{ action: 'redirect' }])).to.throw(/redirectURL/);
+      expect(() => ses.webRequest.setRules([{ urls: 'https://*' as any, action: 'block' }])).to.throw(/'urls' must be an Array/);
+      expect(() => ses.webRequest.setRules([{ action: 'modifyHeaders', requestHeaders: { 'X-Foo': 'a\r\nX-Bar: b' } }])).to.throw(/Invalid value for header 'X-Foo'/);
+      expect(() => ses.webRequest.setRules([{ action: 'modifyHeaders', responseHeaders: { 'X Foo': 'a' } }])).to.throw(/Invalid header name/);
+    });
+  });
+
   describe('webRequest.onBeforeSendHeaders', () => {
     afterEach(() => {
       ses.webRequest.onBeforeSendHeaders(null);
@@ -254,6 +350,21 @@ describe('webRequest module', () => {
       ses.webRequest.onHeadersReceived(null);
     });
 
+    it('exposes lazily computed details as regular properties', async () => {
+      let keys: string[] = [];
+      let cloned: any;
+      ses.webRequest.onHeadersReceived((details, callback) => {
+        keys = Object.keys(details);
+        cloned = JSON.parse(JSON.stringify({ responseHeaders: details.responseHeaders }));
+        details.responseHeaders!.Custom = ['Mutated'];
+        expect(details.responseHeaders!.Custom).to.deep.equal(['Mutated']);
+        callback({});
+      });
+      await ajax(defaultURL);
+      expect(keys).to.include.members(['responseHeaders', 'frame', 'url']);
+      expect(cloned.responseHeaders.Custom).to.deep.equal(['Header']);
+    });
+
     it('receives details object', async () => {
       ses.webRequest.onHeadersReceived((details, callback) => {
         expect(details.statusLine).to.equal('HTTP/1.1 200 OK');
@@ -19,3 +19,11 @@ describe('feature-string parsing', () => {
     checkParse(' a = yes , c = d ', { a: true, c: 'd' });
   });
 });
+
+describe('gin_helper::Dictionary', () => {
+  it('does not cache property names read from a reused buffer', () => {
+    const v8Util = process._linkedBinding('electron_common_v8_util');
+    const object = v8Util.setPropertiesFromBufferForTesting(['first', 'second', 'third']);
+    expect(object).to.deep.equal({ first: 0, second: 1, third: 2 });
+  });
+});
@@ -339,6 +339,51 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('encode(options)', () => {
+    it('encodes to PNG by default', async () => {
+      const image = nativeImage.createFromPath(getImage({ filename: 'logo.png' }).path);
+      const encoded = await image.encode();
+      const decoded = nativeImage.createFromBuffer(encoded);
+      expect(decoded.getSize()).to.deep.equal(image.getSize());
+      expect(decoded.toBitmap().equals(image.toBitmap())).to.be.true();
+    });
+
+    it('encodes a resized image to PNG', async () => {
+      const image = nativeImage.createFromPath(getImage({ filename: 'logo.png' }).path).resize({ width: 100 });
+      for (const fast of [false, true]) {
+        const decoded = nativeImage.createFromBuffer(await image.encode({ format: 'png', fast }));
+        expect(decoded.getSize()).to.deep.equal(image.getSize());
+      }
+    });
+
+    it('encodes to JPEG', async () => {
+      const image = nativeImage.createFromPath(getImage({ filename: 'logo.png' }).path);
+      const encoded = await image.encode({ format: 'jpeg', quality: 50 });
+      expect(encoded.slice(0, 2).toString('hex')).to.equal('ffd8');
+      expect(nativeImage.createFromBuffer(encoded).getSize()).to.deep.equal(image.getSize());
+    });
+
+    it('encodes to WebP', async () => {
+      const image = nativeImage.createFromPath(getImage({ filename: 'logo.png' }).path);
+      for (const lossless of [false, true]) {
+        const encoded = await image.encode({ format: 'webp', lossless });
+        expect(encoded.slice(0, 4).toString()).to.equal('RIFF');
+        expect(encoded.slice(8, 12).toString()).to.equal('WEBP');
+      }
+    });
+
+    it('resolves with an empty buffer for an empty image', async () => {
+      const encoded = await nativeImage.createEmpty().encode({ format: 'jpeg' });
+      expect(encoded.length).to.equal(0);
+    });
+
+    it('rejects invalid options', async () => {
+      const image = nativeImage.createFromPath(getImage({ filename: 'logo.png' }).path);
+      await expect(image.encode({ format: 'gif' })).to.eventually.be.rejectedWith(/Unsupported image format/);
+      await expect(image.encode({ format: 'jpeg', quality: 101 })).to.eventually.be.rejectedWith(/quality/);
+    });
+  });
+
   describe('createFromPath(path)', () => {
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty()).to.be.true();
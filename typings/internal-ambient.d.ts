@@ -51,6 +51,7 @@ declare namespace NodeJS {
     runUntilIdle(): void;
     isSameOrigin(a: string, b: string): boolean;
     triggerFatalErrorForTesting(): void;
+    setPropertiesFromBufferForTesting(names: string[]): Record<string, number>;
   }
 
   interface EnvironmentBinding {
@@ -147,6 +148,9 @@ declare namespace NodeJS {
     hasUserActivation?: boolean;
     mode?: string;
     destination?: string;
+    bufferSize?: number;
+    savePath?: string;
+    uploadFile?: string | number;
   };
   type ResponseHead = {
     statusCode: number;
@@ -242,6 +246,7 @@ declare namespace NodeJS {
     _linkedBinding(name: 'electron_browser_web_frame_main'): {
       WebFrameMain: typeof Electron.WebFrameMain;
       fromId(processId: number, routingId: number): Electron.WebFrameMain;
+      _broadcast(frames: Electron.WebFrameMain[], internal: boolean, channel: string, args: any[]): void;
     }
     _linkedBinding(name: 'electron_renderer_crash_reporter'): Electron.CrashReporter;
     _linkedBinding(name: 'electron_renderer_ipc'): { ipc: IpcRendererBinding };